@@ -12,6 +12,7 @@ namespace mm
 	struct IAppConfig;
 	struct II18nService;
 	struct IPlatformService;
+	struct ITaskScheduler;
 
 	struct Application
 	{
@@ -20,6 +21,7 @@ namespace mm
 		virtual IAppConfig&       appConfig() const       = 0;
 		virtual II18nService&     i18nService() const     = 0;
 		virtual IPlatformService& platformService() const = 0;
+		virtual ITaskScheduler&   taskScheduler() const   = 0;
 	};
 }
 
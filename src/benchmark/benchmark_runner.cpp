@@ -0,0 +1,302 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#include "stdafx.h"
+
+#include "benchmark_runner.hpp"
+
+#include "application.h"
+#include "domain/mod_conflict_resolver.hpp"
+#include "domain/mod_dependency_graph.hpp"
+#include "era2/era2_archive_reader.hpp"
+#include "era2/era2_mod_data_loader.hpp"
+#include "era2/era2_mod_data_provider.hpp"
+#include "era2/era2_mod_files.hpp"
+#include "era2/era2_mod_list_storage.hpp"
+#include "era2/era2_vfs_index.hpp"
+#include "interface/iapp_config.hpp"
+#include "service/icon_storage.hpp"
+#include "system_info.hpp"
+#include "ui/mod_list_model.h"
+#include "utility/directory_walker.hpp"
+#include "utility/progress_channel.hpp"
+#include "utility/sdlexcept.h"
+
+#include <chrono>
+#include <numeric>
+
+using namespace mm;
+
+namespace
+{
+	struct Result
+	{
+		std::string         name;
+		std::vector<double> samples;    // milliseconds
+		size_t              items = 0;  // processed per iteration, if per item cost is reported
+	};
+
+	template <typename F>
+	Result measure(std::string name, size_t iterations, F&& f)
+	{
+		Result result { std::move(name) };
+
+		for (size_t i = 0; i < iterations; ++i)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			f();
+			const auto elapsed = std::chrono::steady_clock::now() - start;
+
+			result.samples.emplace_back(std::chrono::duration<double, std::milli>(elapsed).count());
+		}
+
+		return result;
+	}
+
+	nlohmann::json toJson(const Result& result)
+	{
+		auto sorted = result.samples;
+		std::ranges::sort(sorted);
+
+		nlohmann::json json = {
+			{ "name", result.name },
+			{ "iterations", sorted.size() },
+			{ "min_ms", sorted.front() },
+			{ "median_ms", sorted[sorted.size() / 2] },
+			{ "mean_ms", std::accumulate(sorted.cbegin(), sorted.cend(), 0.0) / sorted.size() },
+			{ "max_ms", sorted.back() },
+		};
+
+		if (result.items > 0)
+		{
+			json["items"]              = result.items;
+			json["median_ns_per_item"] = sorted[sorted.size() / 2] * 1'000'000 / result.items;
+		}
+
+		return json;
+	}
+
+	nlohmann::json toJson(const Benchmark::SyntheticInstallOptions& options)
+	{
+		return {
+			{ "mods", options.mods },
+			{ "dependency_depth", options.dependencyDepth },
+			{ "max_requires", options.maxRequires },
+			{ "incompatible_percent", options.incompatiblePercent },
+			{ "enabled_percent", options.enabledPercent },
+			{ "archive_percent", options.archivePercent },
+			{ "archive_entries", options.archiveEntries },
+			{ "loose_files", options.looseFiles },
+			{ "seed", options.seed },
+		};
+	}
+
+	std::vector<wxDataViewItem> allItems(const ModListModel& model)
+	{
+		std::vector<wxDataViewItem> result;
+
+		wxDataViewItemArray children;
+		model.GetChildren(wxDataViewItem(), children);
+
+		for (const auto& item : children)
+		{
+			if (!model.IsContainer(item))
+			{
+				result.emplace_back(item);
+				continue;
+			}
+
+			wxDataViewItemArray nested;
+			model.GetChildren(item, nested);
+			result.insert(result.end(), nested.begin(), nested.end());
+		}
+
+		return result;
+	}
+}
+
+fs::path Benchmark::run(Application& app, const Options& options)
+{
+	MM_PRECONDTION(options.iterations > 0);
+
+	const auto modsPath   = options.workDir / "Mods";
+	const auto activePath = modsPath / "list.txt";
+	const auto cachePath  = options.workDir / "mod_data.cache";
+	const auto lng        = app.appConfig().currentLanguageCode();
+
+	generateSyntheticInstall(options.workDir, options.install);
+
+	boost::system::error_code ec;
+	remove(cachePath, ec);  // metadata is loaded from scratch
+
+	auto modIds = std::make_shared<ModIdTable>();
+
+	std::vector<Result> results;
+
+	ModList mods(modIds);
+	results.emplace_back(measure("era2_list_load", options.iterations,
+		[&] { mods = Era2ModListStorage::load(activePath, modsPath, modIds); }));
+
+	results.emplace_back(measure("era2_list_save", options.iterations,
+		[&] { Era2ModListStorage::save(activePath, modsPath, mods); }));
+
+	const auto fsNames = Era2ModListStorage::loadFsMapNames(modsPath);
+
+	results.emplace_back(measure("era2_mod_data_loader_load", options.iterations, [&] {
+		for (const auto& [id, dir] : fsNames)
+			Era2ModDataLoader::load(id, modsPath / dir, lng, {}, {}, {}, *modIds, app.i18nService());
+	}));
+
+	Era2ModDataProvider provider(
+		modsPath, fsNames, lng, app.i18nService(), app.taskScheduler(), cachePath, modIds);
+
+	std::vector<ModId> all;
+	for (const auto& item : mods.data())
+		all.emplace_back(item.id);
+	all.insert(all.end(), mods.rest().cbegin(), mods.rest().cend());
+
+	results.emplace_back(measure("era2_mod_data_provider_prefetch", 1, [&] { provider.prefetch(all); }));
+
+	std::vector<std::string> resolved;
+	results.emplace_back(measure("resolve_mod_conflicts", options.iterations,
+		[&] { resolved = ResolveModConflicts(mods, provider, {}, {}); }));
+
+	const ModDependencyGraph graph(mods, provider);
+	results.emplace_back(measure("resolve_mod_conflicts_prepared_graph", options.iterations,
+		[&] { resolved = ResolveModConflicts(mods, graph, {}, {}); }));
+
+	results.emplace_back(measure("resolve_would_be_disabled", options.iterations,
+		[&] { ResolveWouldBeDisabled(mods, graph); }));
+
+	results.emplace_back(measure("mod_list_apply", options.iterations, [&] {
+		auto copy = mods;
+		copy.apply(resolved, false);
+	}));
+
+	IconStorage                   iconStorage(app.appConfig().interfaceSize());
+	wxObjectDataPtr<ModListModel> model(new ModListModel(provider, iconStorage));
+
+	results.emplace_back(
+		measure("mod_list_model_reload", options.iterations, [&] { model->modList(mods); }));
+
+	// same comparisons as view does, when user sorts list by column
+	results.emplace_back(measure("mod_list_model_sort_by_name", options.iterations, [&] {
+		const auto column = static_cast<unsigned int>(ModListModelColumn::name);
+
+		auto items = allItems(*model);
+		std::ranges::sort(items, [&](const wxDataViewItem& left, const wxDataViewItem& right) {
+			return model->Compare(left, right, column, true) < 0;
+		});
+	}));
+
+	auto listFiles = [&](const fs::path& manifestCachePath, std::stop_token token = {},
+						 const BatchCallback& onBatch = {}, Era2VfsIndex* vfsIndex = nullptr) {
+		ProgressChannel progress;
+		return listModFiles(app.taskScheduler(), token, mods.enabled(), Era2GameFiles::none, true, true,
+			provider, options.workDir, manifestCachePath, progress, vfsIndex, onBatch);
+	};
+
+	// what every scanned directory and hashed file costs to worker
+	constexpr size_t progressUpdates = 100'000;
+	ProgressChannel  progressChannel;
+	results.emplace_back(measure("progress_channel_update", options.iterations, [&] {
+		for (size_t i = 0; i < progressUpdates; ++i)
+		{
+			progressChannel.setItem("Mods/bm_mod_00000/Data/s/script00000.erm");
+			progressChannel.advance();
+		}
+	}));
+	results.back().items = progressUpdates;
+
+	// walking of mod directories alone, as scanner did it before and as it does now
+	size_t walked = 0;
+	results.emplace_back(measure("walk_mod_files_fs_relative", options.iterations, [&] {
+		walked = 0;
+
+		using rdi = fs::recursive_directory_iterator;
+		for (auto it = rdi(modsPath), end = rdi(); it != end; ++it)
+		{
+			const auto relative = fs::relative(it->path(), modsPath, ec);
+			Era2ArchiveReader::isArchive(relative);
+			++walked;
+		}
+	}));
+	results.back().items = walked;
+
+	results.emplace_back(measure("walk_mod_files_walker", options.iterations, [&] {
+		walked = 0;
+
+		for (DirectoryWalker walker(modsPath); walker.next();)
+		{
+			Era2ArchiveReader::isArchiveExtension(walker.extension());
+			++walked;
+		}
+	}));
+	results.back().items = walked;
+
+	results.emplace_back(measure("list_mod_files", options.iterations, [&] { listFiles({}); }));
+
+	// time until file list dialog can show first rows, scan is stopped after that
+	results.emplace_back(measure("list_mod_files_first_batch", options.iterations, [&] {
+		std::stop_source stop;
+		listFiles({}, stop.get_token(), [&](Era2FileListBatch) { stop.request_stop(); });
+	}));
+
+	const auto manifestCachePath = options.workDir / "file_manifest.cache";
+	remove(manifestCachePath, ec);
+	listFiles(manifestCachePath);
+
+	results.emplace_back(measure(
+		"list_mod_files_cached", options.iterations, [&] { listFiles(manifestCachePath); }));
+
+	Era2VfsIndex vfsIndex;
+	const auto   files = listFiles(manifestCachePath, {}, {}, &vfsIndex);
+
+	results.emplace_back(measure("vfs_index_lookup", options.iterations, [&] {
+		for (const auto& entry : files.entries)
+			vfsIndex.find(files.paths[entry.filePath]);
+	}));
+
+	auto collapseIdentical = [&](const fs::path& hashCachePath) {
+		ProgressChannel progress;
+		auto            copy = files;
+		collapseIdenticalFiles(app.taskScheduler(), {}, copy, true, options.workDir, hashCachePath, progress);
+	};
+
+	results.emplace_back(
+		measure("collapse_identical_files", options.iterations, [&] { collapseIdentical({}); }));
+
+	const auto hashCachePath = options.workDir / "content_hash.cache";
+	remove(hashCachePath, ec);
+	collapseIdentical(hashCachePath);
+
+	results.emplace_back(measure(
+		"collapse_identical_files_cached", options.iterations, [&] { collapseIdentical(hashCachePath); }));
+
+	// swaps two mods in the middle of list, as user does when moving mod by one position
+	auto order = mods.enabled();
+	results.emplace_back(measure("vfs_index_reorder", options.iterations, [&] {
+		if (order.size() >= 2)
+			std::swap(order[order.size() / 2 - 1], order[order.size() / 2]);
+
+		vfsIndex.setOrder(order);
+	}));
+
+	nlohmann::json report = {
+		{ "program", SystemInfo::ProgramVersion },
+		{ "install", toJson(options.install) },
+		{ "results", nlohmann::json::array() },
+	};
+
+	for (const auto& item : results)
+		report["results"].emplace_back(toJson(item));
+
+	const auto output = options.workDir / "benchmark.json";
+
+	boost::nowide::ofstream f(output, std::ios_base::out | std::ios_base::binary);
+	f << report.dump(2);
+
+	return output;
+}
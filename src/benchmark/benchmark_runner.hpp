@@ -0,0 +1,27 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "synthetic_install.hpp"
+
+namespace mm
+{
+	struct Application;
+}
+
+namespace mm::Benchmark
+{
+	struct Options
+	{
+		fs::path                workDir;
+		SyntheticInstallOptions install;
+		size_t                  iterations = 5;
+	};
+
+	// Generates synthetic install inside of work dir, measures core operations on it
+	// and writes results as json. Returns path to written file
+	fs::path run(Application& app, const Options& options);
+}
@@ -0,0 +1,185 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#include "stdafx.h"
+
+#include "synthetic_install.hpp"
+
+#include "system_info.hpp"
+#include "utility/sdlexcept.h"
+
+#include <array>
+#include <cstring>
+#include <random>
+
+using namespace mm;
+
+namespace
+{
+	constexpr std::array categories = { "gameplay", "graphics", "sound", "interface", "other" };
+
+	// written into generated `Mods`, so that real installation is never taken for previous synthetic run
+	constexpr auto MarkerFilename = ".sdmm_synthetic_install";
+
+	void writeText(const fs::path& path, const std::string& content)
+	{
+		boost::nowide::ofstream f(path, std::ios_base::out | std::ios_base::binary);
+		MM_EXPECTS(f, unexpected_error);
+
+		f << content;
+	}
+
+	void writeUInt32(std::ostream& out, std::uint32_t value)
+	{
+		out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
+	// only header and entry table, nothing reads content of synthetic archives
+	void writeLod(const fs::path& path, size_t firstEntry, size_t entries)
+	{
+		boost::nowide::ofstream f(path, std::ios_base::out | std::ios_base::binary);
+		MM_EXPECTS(f, unexpected_error);
+
+		const auto           count  = static_cast<std::uint32_t>(entries);
+		std::array<char, 92> header = { 'L', 'O', 'D', '\0' };
+		std::memcpy(header.data() + 8, &count, sizeof(count));
+		f.write(header.data(), header.size());
+
+		for (size_t i = 0; i < entries; ++i)
+		{
+			std::array<char, 16> name = {};
+			std::snprintf(name.data(), name.size(), "f%06zu.def", firstEntry + i);
+			f.write(name.data(), name.size());
+
+			writeUInt32(f, 0);  // offset
+			writeUInt32(f, 0);  // size
+			writeUInt32(f, 0);  // type
+			writeUInt32(f, 0);  // compressed size
+		}
+	}
+
+	std::vector<std::string> pick(
+		std::mt19937& random, size_t first, size_t last, size_t count, size_t except = size_t(-1))
+	{
+		std::vector<std::string> result;
+
+		if (first >= last)
+			return result;
+
+		std::uniform_int_distribution<size_t> dist(first, last - 1);
+		for (size_t i = 0; i < count; ++i)
+			if (const auto index = dist(random); index != except)
+				result.emplace_back(Benchmark::syntheticModId(index));
+
+		std::ranges::sort(result);
+		result.erase(std::unique(result.begin(), result.end()), result.end());
+
+		return result;
+	}
+}
+
+std::string Benchmark::syntheticModId(size_t index)
+{
+	char buffer[32] = {};
+	std::snprintf(buffer, sizeof(buffer), "bm_mod_%05zu", index);
+
+	return buffer;
+}
+
+void Benchmark::generateSyntheticInstall(const fs::path& root, const SyntheticInstallOptions& options)
+{
+	MM_PRECONDTION(options.mods > 0);
+
+	const auto modsPath = root / "Mods";
+
+	const bool generated = !exists(modsPath) || is_empty(modsPath) || exists(modsPath / MarkerFilename);
+	MM_EXPECTS(generated, unexpected_error);
+
+	remove_all(modsPath);
+	create_directories(modsPath);
+	writeText(modsPath / MarkerFilename, "");
+
+	std::mt19937                       random(options.seed);
+	std::uniform_int_distribution<int> percent(0, 99);
+
+	create_directories(modsPath / "WoG");
+	writeText(modsPath / "WoG" / SystemInfo::ModInfoFilename,
+		nlohmann::json { { "name", { { "en", "WoG" } } }, { "category", "gameplay" } }.dump(2));
+
+	// mods are split into blocks by depth, mod can require only mods from previous block
+	const size_t levels = options.dependencyDepth + 1;
+	auto         level  = [&](size_t index) { return index * levels / options.mods; };
+	auto         first  = [&](size_t l) { return (l * options.mods + levels - 1) / levels; };
+
+	std::uniform_int_distribution<size_t> requiresCount(0, options.maxRequires);
+	std::uniform_int_distribution<size_t> looseFile(0, options.looseFiles * 4);
+	std::uniform_int_distribution<size_t> archiveStart(0, options.archiveEntries * 4);
+	std::uniform_int_distribution<int>    priority(1, 3);
+
+	for (size_t i = 0; i < options.mods; ++i)
+	{
+		const auto id      = syntheticModId(i);
+		const auto modPath = modsPath / id;
+		const auto l       = level(i);
+
+		create_directories(modPath / "Data" / "s");
+
+		nlohmann::json data = {
+			{ "name", { { "en", "Synthetic mod " + std::to_string(i) },
+						  { "ru", "Синтетический мод " + std::to_string(i) } } },
+			{ "description", { { "en", "readme.txt" } } },
+			{ "author", "author " + std::to_string(i % 37) },
+			{ "version", "1.0." + std::to_string(i % 10) },
+			{ "category", categories[i % categories.size()] },
+		};
+
+		// mods are placed before mods they load after, so only top level may have higher priority
+		if (l == levels - 1 && percent(random) < 10)
+			data["priority"] = priority(random);
+
+		if (l > 0)
+		{
+			nlohmann::json compatibility = {
+				{ "requires", pick(random, first(l - 1), first(l), requiresCount(random)) },
+			};
+
+			if (percent(random) < 20)
+				compatibility["load_after"] = pick(random, 0, first(l), 1);
+
+			if (percent(random) < static_cast<int>(options.incompatiblePercent))
+				compatibility["incompatible"] = pick(random, first(l), first(l + 1), 1, i);
+
+			data["compatibility"] = std::move(compatibility);
+		}
+
+		writeText(modPath / SystemInfo::ModInfoFilename, data.dump(2));
+		writeText(modPath / "readme.txt", "Synthetic mod " + std::to_string(i) + " for benchmarking.\n");
+
+		for (size_t j = 0; j < options.looseFiles; ++j)
+		{
+			const auto name = "script" + std::to_string(looseFile(random)) + ".erm";
+			writeText(modPath / "Data" / "s" / name, id);
+		}
+
+		if (percent(random) < static_cast<int>(options.archivePercent))
+			writeLod(modPath / "Data" / (id + ".lod"), archiveStart(random), options.archiveEntries);
+	}
+
+	std::vector<std::string> list;
+	for (size_t i = 0; i < options.mods; ++i)
+	{
+		const int roll = percent(random);
+
+		if (roll < static_cast<int>(options.enabledPercent))
+			list.emplace_back(syntheticModId(i));
+		else if (roll < static_cast<int>(options.enabledPercent) + 10)
+			list.emplace_back('*' + syntheticModId(i));
+	}
+
+	std::ranges::shuffle(list, random);
+	list.emplace_back("WoG");
+
+	writeText(modsPath / "list.txt", boost::join(list, "\n"));
+}
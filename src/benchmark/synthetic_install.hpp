@@ -0,0 +1,34 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "type/filesystem.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace mm::Benchmark
+{
+	struct SyntheticInstallOptions
+	{
+		size_t        mods                = 1000;
+		size_t        dependencyDepth     = 4;  // longest chain of requirements
+		size_t        maxRequires         = 3;
+		unsigned      incompatiblePercent = 5;
+		unsigned      enabledPercent      = 70;
+		unsigned      archivePercent      = 10;  // mods having lod archive
+		size_t        archiveEntries      = 3000;
+		size_t        looseFiles          = 20;
+		std::uint32_t seed                = 1;
+	};
+
+	// Creates Era-like `Mods` directory inside of root: mods with randomized mod.json, readme, loose files
+	// and lod archives (entry tables only), plus list.txt. Previous content of `Mods` is removed only if it was
+	// generated by this function; non-empty `Mods` without marker file is refused
+	void generateSyntheticInstall(const fs::path& root, const SyntheticInstallOptions& options);
+
+	std::string syntheticModId(size_t index);
+}
@@ -8,183 +8,364 @@
 #include <wx/string.h>
 
 #include "application.h"
-#include "domain/mod_data.hpp"
+#include "domain/mod_dependency_graph.hpp"
 #include "domain/mod_list.hpp"
-#include "interface/imod_data_provider.hpp"
 #include "mod_conflict_resolver.hpp"
 
 #include <boost/range/algorithm_ext/erase.hpp>
-#include <set>
 
 using namespace mm;
 
 namespace
 {
-	struct CompatibilityInfo
+	void expandRequirements(std::vector<ModId>& where, std::unordered_set<ModId>& present,
+		std::unordered_set<ModId>& expanded, const ModDependencyGraph& graph, ModId currentId)
 	{
-		int priority = 0;
-
-		std::set<std::string> incompatible;
-		std::set<std::string> requires_;
-		std::set<std::string> load_after;
-	};
-
-	using CompatMap = std::unordered_map<std::string, CompatibilityInfo>;
+		if (!expanded.emplace(currentId).second)  // whole requirements chain is already added
+			return;
 
-	void expandRequirements(
-		std::vector<std::string>& where, CompatMap& cm, const std::string& currentId)
-	{
-		if (std::find(where.begin(), where.end(), currentId) == where.end())
+		if (present.emplace(currentId).second)
 			where.emplace_back(currentId);
 
-		const auto& modData = cm[currentId];
-		for (const auto& id : modData.requires_)
-			expandRequirements(where, cm, id);
+		for (const auto& id : graph.node(currentId).requires_)
+			expandRequirements(where, present, expanded, graph, id);
 	}
 
-	void reduceRequirements(std::set<std::string>& where, const std::vector<std::string>& active,
-		CompatMap& cm, const std::string& currentId)
+	void reduceRequirements(std::unordered_set<ModId>& where, const std::unordered_set<ModId>& active,
+		const ModDependencyGraph& graph, ModId currentId)
 	{
-		if (where.contains(currentId))  // requirements chain already added
+		if (!where.emplace(currentId).second)  // requirements chain already added
 			return;
 
-		where.emplace(currentId);
-
-		for (const auto& id : active)
-		{
-			const auto& modData = cm[id];
-			if (modData.requires_.contains(currentId))
-				reduceRequirements(where, active, cm, id);
-		}
+		for (const auto& id : graph.node(currentId).requiredBy)
+			if (active.contains(id))
+				reduceRequirements(where, active, graph, id);
 	}
 
 	void reduceRequirementsTop(
-		std::vector<std::string>& active, CompatMap& cm, const std::string& currentId)
+		std::vector<ModId>& active, const ModDependencyGraph& graph, std::optional<ModId> currentId)
 	{
-		if (currentId.empty())
+		if (!currentId)
 			return;
 
-		std::set<std::string> reducedRequirements;
-		reduceRequirements(reducedRequirements, active, cm, currentId);
+		const std::unordered_set<ModId> activeSet(active.cbegin(), active.cend());
+
+		std::unordered_set<ModId> reducedRequirements;
+		reduceRequirements(reducedRequirements, activeSet, graph, *currentId);
 
 		boost::range::remove_erase_if(
-			active, [&](const std::string& item) { return reducedRequirements.contains(item); });
+			active, [&](const ModId& item) { return reducedRequirements.contains(item); });
 	}
 
-	void reduceIncompatibleChain(
-		std::vector<std::string>& active, CompatMap& cm, const std::string& currentId)
+	void reduceIncompatibleChain(std::vector<ModId>& active, std::unordered_set<ModId>& visited,
+		const ModDependencyGraph& graph, std::optional<ModId> currentId)
 	{
-		if (currentId.empty())
+		if (!currentId || !visited.emplace(*currentId).second)
 			return;
 
-		for (const auto& id : cm[currentId].incompatible)
-			reduceRequirementsTop(active, cm, id);
+		for (const auto& id : graph.node(*currentId).incompatible)
+			reduceRequirementsTop(active, graph, id);
 
-		for (const auto& id : cm[currentId].requires_)
-			reduceIncompatibleChain(active, cm, id);
+		for (const auto& id : graph.node(*currentId).requires_)
+			reduceIncompatibleChain(active, visited, graph, id);
 	}
 
-	CompatMap prepareCompatibiltityMap(const ModList& mods, IModDataProvider& modDataProvider)
+	void reduceIncompatibleChain(
+		std::vector<ModId>& active, const ModDependencyGraph& graph, std::optional<ModId> currentId)
 	{
-		// copy compatibility info from data provider
-		CompatMap cm;
-
-		auto addCompat = [&](const std::string& id) {
-			auto [it, _] = cm.insert({ id, {} });
+		std::unordered_set<ModId> visited;
+		reduceIncompatibleChain(active, visited, graph, currentId);
+	}
 
-			auto& data = modDataProvider.modData(id);
+	std::optional<ModId> toModId(const ModList& mods, const std::string& id)
+	{
+		if (id.empty())
+			return {};
 
-			it->second.priority = data.priority;
+		return mods.ids->intern(id);
+	}
 
-			it->second.incompatible = data.incompatible;
-			it->second.requires_    = data.requires_;
-			it->second.load_after   = data.load_after;
-		};
+	bool loadsAfter(const ModDependencyGraph::Node& node, ModId id)
+	{
+		return std::ranges::find(node.loadAfter, id) != node.loadAfter.cend();
+	}
 
+	// same order could be produced by sort without falling back on cycles
+	bool isSorted(const std::vector<ModId>& order, const ModDependencyGraph& graph)
+	{
+		std::unordered_map<ModId, size_t> position;
+		for (size_t i = 0; i < order.size(); ++i)
+			position.emplace(order[i], i);
 
-		for (const auto& mod : mods.data)
-			addCompat(mod.id);
+		for (size_t i = 0; i < order.size(); ++i)
+		{
+			const auto& node = graph.node(order[i]);
 
-		for (const auto& id : mods.rest)
-			addCompat(id);
+			if (i > 0 && graph.node(order[i - 1]).priority < node.priority)
+				return false;
 
-		// incompatibility info is viral
-		for (auto& [key, value] : cm)
-		{
-			for (const auto& item : value.incompatible)
-				cm[item].incompatible.insert(key);
+			for (const auto& id : node.loadAfter)
+				if (auto it = position.find(id); it != position.cend() && it->second < i)
+					return false;
 		}
 
-		return cm;
+		return true;
+	}
+
+	std::vector<std::string> toStrings(const ModList& mods, const std::vector<ModId>& ids)
+	{
+		std::vector<std::string> result;
+		result.reserve(ids.size());
+
+		for (const auto& id : ids)
+			result.emplace_back(mods.string(id));
+
+		return result;
 	}
 }
 
 std::vector<std::string> mm::ResolveModConflicts(const ModList& mods, IModDataProvider& modDataProvider,
 	const std::string& enablingMod, const std::string& disablingMod)
 {
-	auto cm = prepareCompatibiltityMap(mods, modDataProvider);
+	return ResolveModConflicts(mods, ModDependencyGraph(mods, modDataProvider), enablingMod, disablingMod);
+}
 
+std::vector<std::string> mm::ResolveModConflicts(const ModList& mods, const ModDependencyGraph& graph,
+	const std::string& enablingMod, const std::string& disablingMod)
+{
 	// expand current mod list to contain all mods, required by active mods
-	std::vector<std::string> expandedRequirements;
-	for (const auto& mod : mods.data)
+	std::vector<ModId>        expandedRequirements;
+	std::unordered_set<ModId> present;
+	for (const auto& mod : mods.data())
+	{
 		if (mod.state == ModList::ModState::enabled)
+		{
 			expandedRequirements.emplace_back(mod.id);
+			present.emplace(mod.id);
+		}
+	}
 
-	for (const auto& mod : mods.data)
+	std::unordered_set<ModId> expanded;
+	for (const auto& mod : mods.data())
 		if (mod.state == ModList::ModState::enabled)
-			expandRequirements(expandedRequirements, cm, mod.id);
+			expandRequirements(expandedRequirements, present, expanded, graph, mod.id);
 
 	// remove mods if user disables mod
 	// then remove mods, incompatible with mod, which user enables
 	// then remove mods, incompatible with top mods
-	reduceRequirementsTop(expandedRequirements, cm, disablingMod);
-	reduceIncompatibleChain(expandedRequirements, cm, enablingMod);
+	reduceRequirementsTop(expandedRequirements, graph, toModId(mods, disablingMod));
+	reduceIncompatibleChain(expandedRequirements, graph, toModId(mods, enablingMod));
 
 	for (size_t i = 0; i < expandedRequirements.size(); ++i)
 	{
 		const auto copy = expandedRequirements[i];
-		reduceIncompatibleChain(expandedRequirements, cm, copy);
+		reduceIncompatibleChain(expandedRequirements, graph, copy);
+	}
+
+	const auto sorted = graph.sort(expandedRequirements, [&](const std::vector<ModId>& remaining) {
+		std::vector<std::string> names;
+		for (const auto& id : remaining)
+			names.emplace_back(mods.string(id));
+
+		wxLogWarning(wxString::Format("message/warning/no_mods_can_be_placed_above_each_other"_lng,
+			wxString::FromUTF8(boost::join(names, ", ")), wxString::FromUTF8(names.front())));
+	});
+
+	return toStrings(mods, sorted);
+}
+
+std::optional<std::vector<std::string>> mm::ResolveModConflictsIncrementally(const ModList& mods,
+	const ModDependencyGraph& graph, const std::vector<std::string>& resolved, const std::string& enablingMod,
+	const std::string& disablingMod)
+{
+	if (enablingMod.empty() == disablingMod.empty())
+		return {};
+
+	const auto toggled = mods.ids->find(enablingMod.empty() ? disablingMod : enablingMod);
+	if (!toggled)
+		return {};
+
+	// previous result without toggled mod must match current list, otherwise it isn't known to be resolved
+	std::vector<ModId> order;
+	order.reserve(resolved.size());
+
+	for (const auto& item : resolved)
+	{
+		const auto id = mods.ids->find(item);
+		if (!id)
+			return {};
+
+		if (*id != *toggled)
+			order.emplace_back(*id);
+	}
+
+	size_t matched = 0;
+	for (const auto& mod : mods.data())
+	{
+		if (mod.state != ModList::ModState::enabled || mod.id == *toggled)
+			continue;
+
+		if (matched == order.size() || order[matched] != mod.id)
+			return {};
+
+		++matched;
 	}
 
-	std::vector<std::string> sortedActive;
+	if (matched != order.size())
+		return {};
 
-	for (size_t i = 0; !expandedRequirements.empty();)
+	// affected mods: requirements of enabled mod, mods incompatible with them and everything depending on
+	// removed mods; rest of the list is already resolved and keeps its order
+	std::unordered_set<ModId> active(order.cbegin(), order.cend());
+	std::unordered_set<ModId> removed;
+	std::vector<ModId>        added;
+
+	if (!disablingMod.empty())
+	{
+		active.emplace(*toggled);
+		reduceRequirements(removed, active, graph, *toggled);
+	}
+	else
 	{
-		const auto& candidate = expandedRequirements[i];
+		std::vector<ModId>        chain;
+		std::unordered_set<ModId> present;
+		std::unordered_set<ModId> expanded;
+		expandRequirements(chain, present, expanded, graph, *toggled);
 
-		bool ok = true;
-		for (size_t j = 0; ok && j < expandedRequirements.size(); ++j)
+		for (const auto& id : chain)
+			for (const auto& incompatible : graph.node(id).incompatible)
+				reduceRequirements(removed, active, graph, incompatible);
+
+		// outcome of conflicts inside of chain depends on order, leave it to full resolve
+		for (const auto& id : chain)
 		{
-			if (i == j)
-				continue;
+			if (removed.contains(id))
+				return {};
+
+			if (!active.contains(id))
+				added.emplace_back(id);
+		}
+	}
+
+	std::vector<ModId> result;
+	result.reserve(order.size() + added.size());
 
-			if (cm[expandedRequirements[j]].load_after.contains(candidate))
-				ok = false;
+	for (const auto& id : order)
+		if (!removed.contains(id))
+			result.emplace_back(id);
 
-			if (cm[expandedRequirements[j]].priority > cm[candidate].priority)
-				ok = false;
+	for (const auto& id : added)
+	{
+		const auto& node = graph.node(id);
+
+		size_t lowest  = 0;
+		size_t highest = result.size();
+
+		for (size_t i = 0; i < result.size(); ++i)
+		{
+			const auto& other = graph.node(result[i]);
+
+			if (other.priority > node.priority || loadsAfter(other, id))
+				lowest = i + 1;
+
+			if (highest == result.size() && (other.priority < node.priority || loadsAfter(node, result[i])))
+				highest = i;
 		}
 
-		if (ok)
+		if (lowest > highest)
+			return {};
+
+		// full resolve breaks ties by index in current list: enabled mod keeps its place among active mods,
+		// requirements are appended after them and go as low as possible
+		size_t at = highest;
+		if (id == *toggled)
 		{
-			sortedActive.emplace_back(candidate);
-			expandedRequirements.erase(expandedRequirements.begin() + i);
-			i = 0;
+			const auto position = mods.position(id);
+			const auto current  = static_cast<size_t>(std::ranges::count_if(
+				result, [&](ModId item) { return mods.position(item) < position; }));
+
+			at = std::clamp(current, lowest, highest);
 		}
-		else
+
+		result.emplace(result.begin() + at, id);
+	}
+
+	if (!isSorted(result, graph))
+		return {};
+
+	return toStrings(mods, result);
+}
+
+std::unordered_map<ModId, std::vector<ModId>> mm::ResolveWouldBeDisabled(
+	const ModList& mods, const ModDependencyGraph& graph)
+{
+	std::unordered_set<ModId> active;
+	for (const auto& mod : mods.data())
+		if (mod.state == ModList::ModState::enabled)
+			active.emplace(mod.id);
+
+	// otherwise full resolve would change list even without enabling anything
+	for (const auto& id : active)
+	{
+		const auto& node = graph.node(id);
+
+		if (std::ranges::any_of(node.requires_, [&](ModId item) { return !active.contains(item); }) ||
+			std::ranges::any_of(node.incompatible, [&](ModId item) { return active.contains(item); }))
+			return {};
+	}
+
+	// active mods, disabled together with given one; same mods are incompatible with many candidates
+	std::unordered_map<ModId, std::vector<ModId>> dependents;
+	auto disabledWith = [&](ModId id) -> const std::vector<ModId>& {
+		if (auto it = dependents.find(id); it != dependents.cend())
+			return it->second;
+
+		std::unordered_set<ModId> closure;
+		if (active.contains(id))
+			reduceRequirements(closure, active, graph, id);
+
+		return dependents.emplace(id, std::vector<ModId>(closure.cbegin(), closure.cend())).first->second;
+	};
+
+	std::unordered_map<ModId, std::vector<ModId>> result;
+
+	auto process = [&](ModId candidate) {
+		std::vector<ModId>        chain;
+		std::unordered_set<ModId> present;
+		std::unordered_set<ModId> expanded;
+		expandRequirements(chain, present, expanded, graph, candidate);
+
+		std::unordered_set<ModId> removed;
+		for (const auto& id : chain)
 		{
-			++i;
-			if (i == expandedRequirements.size())
+			for (const auto& incompatible : graph.node(id).incompatible)
 			{
-				wxLogWarning(wxString::Format("message/warning/no_mods_can_be_placed_above_each_other"_lng,
-					wxString::FromUTF8(boost::join(expandedRequirements, ", ")),
-					wxString::FromUTF8(expandedRequirements.front())));
-				sortedActive.emplace_back(expandedRequirements.front());
-				expandedRequirements.erase(expandedRequirements.begin());
-				i = 0;
+				if (present.contains(incompatible))  // conflict inside of chain
+					return;
+
+				const auto& closure = disabledWith(incompatible);
+				removed.insert(closure.cbegin(), closure.cend());
 			}
 		}
-	}
 
-	return sortedActive;
+		// chain loses mod it requires, outcome depends on order
+		auto isRemoved = [&](ModId id) { return removed.contains(id); };
+		for (const auto& id : chain)
+			if (isRemoved(id) || std::ranges::any_of(graph.node(id).requires_, isRemoved))
+				return;
+
+		std::vector<ModId> disabled(removed.cbegin(), removed.cend());
+		std::ranges::sort(disabled, {}, [&](ModId id) { return *mods.position(id); });
+
+		result.emplace(candidate, std::move(disabled));
+	};
+
+	for (const auto& mod : mods.data())
+		if (mod.state != ModList::ModState::enabled)
+			process(mod.id);
+
+	for (const auto& id : mods.rest())
+		process(id);
+
+	return result;
 }
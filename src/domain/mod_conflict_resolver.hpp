@@ -7,10 +7,30 @@
 
 #include "domain/mod_list.hpp"
 
+#include <unordered_map>
+
 namespace mm
 {
 	struct IModDataProvider;
+	struct ModDependencyGraph;
 
 	std::vector<std::string> ResolveModConflicts(const ModList& mods, mm::IModDataProvider& modDataProvider,
 		const std::string& enablingMod, const std::string& disablingMod);
+
+	// graph must be up to date with mods
+	std::vector<std::string> ResolveModConflicts(const ModList& mods, const ModDependencyGraph& graph,
+		const std::string& enablingMod, const std::string& disablingMod);
+
+	// Re-resolves only mods affected by switching state of single mod and keeps order of others.
+	// `resolved` is result of previous resolve, mods may differ from it only by state of that mod.
+	// Returns nothing when full resolve is required
+	std::optional<std::vector<std::string>> ResolveModConflictsIncrementally(const ModList& mods,
+		const ModDependencyGraph& graph, const std::vector<std::string>& resolved,
+		const std::string& enablingMod, const std::string& disablingMod);
+
+	// For every mod which isn't enabled: enabled mods, which full resolve would disable when enabling it,
+	// in order of list. Enabled mods must be resolved already, otherwise result is empty.
+	// Mods, for which outcome depends on order of resolving, are missing from result
+	std::unordered_map<ModId, std::vector<ModId>> ResolveWouldBeDisabled(
+		const ModList& mods, const ModDependencyGraph& graph);
 }
@@ -0,0 +1,184 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#include "stdafx.h"
+
+#include "mod_dependency_graph.hpp"
+
+#include "domain/mod_data.hpp"
+#include "domain/mod_list.hpp"
+#include "interface/imod_data_provider.hpp"
+#include "utility/sdlexcept.h"
+
+#include <map>
+#include <queue>
+
+using namespace mm;
+
+ModDependencyGraph::ModDependencyGraph(const ModList& mods, IModDataProvider& modDataProvider)
+	: _ids(mods.ids)
+	, _generation(modDataProvider.generation())
+{
+	MM_PRECONDTION(mods.ids == modDataProvider.modIds());
+
+	auto addMember = [&](ModId id) {
+		const auto& data = modDataProvider.modData(id);
+
+		// loading data could intern new ids
+		if (_nodes.size() < _ids->size())
+			_nodes.resize(_ids->size());
+
+		auto& node = _nodes[id.value];
+
+		node.member   = true;
+		node.priority = data.priority;
+		node.incompatible.assign(data.incompatible.cbegin(), data.incompatible.cend());
+		node.requires_.assign(data.requires_.cbegin(), data.requires_.cend());
+		node.loadAfter.assign(data.load_after.cbegin(), data.load_after.cend());
+
+		std::ranges::sort(
+			node.requires_, {}, [&](ModId item) -> const std::string& { return _ids->string(item); });
+
+		++_memberCount;
+	};
+
+	for (const auto& mod : mods.data())
+		addMember(mod.id);
+
+	for (const auto& id : mods.rest())
+		addMember(id);
+
+	_nodes.resize(_ids->size());
+
+	for (std::uint32_t i = 0; i < _nodes.size(); ++i)
+	{
+		if (!_nodes[i].member)
+			continue;
+
+		// incompatibility info is viral; loop by index as mod could be incompatible with itself
+		for (size_t j = 0, size = _nodes[i].incompatible.size(); j < size; ++j)
+			_nodes[_nodes[i].incompatible[j].value].incompatible.emplace_back(ModId { i });
+
+		for (const auto& id : _nodes[i].requires_)
+			_nodes[id.value].requiredBy.emplace_back(ModId { i });
+	}
+
+	for (auto& node : _nodes)
+	{
+		std::ranges::sort(node.incompatible);
+		node.incompatible.erase(std::unique(node.incompatible.begin(), node.incompatible.end()),
+			node.incompatible.end());
+	}
+}
+
+bool ModDependencyGraph::upToDate(const ModList& mods, const IModDataProvider& modDataProvider) const
+{
+	if (_ids != mods.ids || _generation != modDataProvider.generation())
+		return false;
+
+	if (_memberCount != mods.data().size() + mods.rest().size())
+		return false;
+
+	return std::ranges::all_of(mods.data(), [&](const ModList::Mod& mod) { return node(mod.id).member; }) &&
+		   std::ranges::all_of(mods.rest(), [&](ModId id) { return node(id).member; });
+}
+
+const ModDependencyGraph::Node& ModDependencyGraph::node(ModId id) const
+{
+	static const Node empty;
+
+	if (id.value < _nodes.size())
+		return _nodes[id.value];
+
+	return empty;
+}
+
+std::vector<ModId> ModDependencyGraph::sort(
+	const std::vector<ModId>& items, const CycleHandler& onCycle) const
+{
+	std::unordered_map<ModId, size_t> index;
+	for (size_t i = 0; i < items.size(); ++i)
+		index.emplace(items[i], i);
+
+	// item can be placed when nothing remaining wants to be loaded after it
+	// and there is no remaining item with greater priority
+	std::vector<size_t>                   blockers(items.size());
+	std::map<int, size_t, std::greater<>> remainingPriorities;
+
+	for (size_t i = 0; i < items.size(); ++i)
+	{
+		const auto& current = node(items[i]);
+
+		++remainingPriorities[current.priority];
+
+		for (const auto& id : current.loadAfter)
+			if (auto it = index.find(id); it != index.cend() && it->second != i)
+				++blockers[it->second];
+	}
+
+	using Candidate = std::pair<int, size_t>;  // -priority, index
+	std::priority_queue<Candidate, std::vector<Candidate>, std::greater<>> ready;
+
+	for (size_t i = 0; i < items.size(); ++i)
+		if (blockers[i] == 0)
+			ready.emplace(-node(items[i]).priority, i);
+
+	std::vector<ModId> result;
+	result.reserve(items.size());
+
+	std::vector<bool> placed(items.size());
+	size_t            firstRemaining = 0;
+
+	auto place = [&](size_t i) {
+		const auto& current = node(items[i]);
+
+		placed[i] = true;
+		result.emplace_back(items[i]);
+
+		if (auto it = remainingPriorities.find(current.priority); --it->second == 0)
+			remainingPriorities.erase(it);
+
+		for (const auto& id : current.loadAfter)
+		{
+			auto it = index.find(id);
+			if (it == index.cend() || it->second == i || placed[it->second])
+				continue;
+
+			if (--blockers[it->second] == 0)
+				ready.emplace(-node(id).priority, it->second);
+		}
+	};
+
+	while (result.size() < items.size())
+	{
+		while (!ready.empty() && placed[ready.top().second])
+			ready.pop();
+
+		if (!ready.empty() && -ready.top().first == remainingPriorities.cbegin()->first)
+		{
+			const auto i = ready.top().second;
+			ready.pop();
+			place(i);
+			continue;
+		}
+
+		while (placed[firstRemaining])
+			++firstRemaining;
+
+		if (onCycle)
+		{
+			std::vector<ModId> remaining;
+			for (size_t i = firstRemaining; i < items.size(); ++i)
+				if (!placed[i])
+					remaining.emplace_back(items[i]);
+
+			onCycle(remaining);
+		}
+
+		place(firstRemaining);
+	}
+
+	return result;
+}
@@ -0,0 +1,54 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "mod_id.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace mm
+{
+	struct IModDataProvider;
+	struct ModList;
+
+	// Compatibility info of mods from list, compiled into adjacency lists indexed by ModId::value
+	struct ModDependencyGraph
+	{
+		struct Node
+		{
+			bool member   = false;  // mod is present in list, graph was built from
+			int  priority = 0;
+
+			std::vector<ModId> incompatible;  // including reverse relations
+			std::vector<ModId> requires_;     // in order of names
+			std::vector<ModId> requiredBy;
+			std::vector<ModId> loadAfter;
+		};
+
+		// called with mods which can't be placed because of cycle, mods are in original order
+		using CycleHandler = std::function<void(const std::vector<ModId>& remaining)>;
+
+		ModDependencyGraph(const ModList& mods, IModDataProvider& modDataProvider);
+
+		// graph remains valid while metadata isn't changed and list contains same mods
+		bool upToDate(const ModList& mods, const IModDataProvider& modDataProvider) const;
+
+		const Node& node(ModId id) const;
+
+		// Returns items ordered by priority and load_after relations, ties are kept in original order.
+		// When nothing can be placed, first remaining item is taken after reporting cycle
+		std::vector<ModId> sort(const std::vector<ModId>& items, const CycleHandler& onCycle) const;
+
+	private:
+		const std::shared_ptr<ModIdTable> _ids;
+		const size_t                      _generation;
+
+		std::vector<Node> _nodes;
+		size_t            _memberCount = 0;
+	};
+}
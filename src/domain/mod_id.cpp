@@ -0,0 +1,56 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#include "stdafx.h"
+
+#include "mod_id.hpp"
+
+#include "utility/sdlexcept.h"
+
+using namespace mm;
+
+ModId ModIdTable::intern(std::string_view id)
+{
+	if (auto result = find(id))
+		return *result;
+
+	std::unique_lock lock(_mutex);
+
+	// somebody could add it while lock wasn't held
+	if (auto it = _ids.find(id); it != _ids.cend())
+		return it->second;
+
+	const ModId result { static_cast<std::uint32_t>(_strings.size()) };
+
+	_ids.emplace(_strings.emplace_back(id), result);
+
+	return result;
+}
+
+std::optional<ModId> ModIdTable::find(std::string_view id) const
+{
+	std::shared_lock lock(_mutex);
+
+	if (auto it = _ids.find(id); it != _ids.cend())
+		return it->second;
+
+	return {};
+}
+
+const std::string& ModIdTable::string(ModId id) const
+{
+	std::shared_lock lock(_mutex);
+
+	MM_PRECONDTION(id.value < _strings.size());
+
+	return _strings[id.value];
+}
+
+size_t ModIdTable::size() const
+{
+	std::shared_lock lock(_mutex);
+
+	return _strings.size();
+}
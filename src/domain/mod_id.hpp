@@ -0,0 +1,52 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <compare>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace mm
+{
+	// Interned (case folded) mod id, makes sense only together with table which created it
+	struct ModId
+	{
+		std::uint32_t value = 0;
+
+		std::strong_ordering operator<=>(const ModId& other) const = default;
+	};
+
+	// Can be used from several threads at once
+	struct ModIdTable
+	{
+		ModId                intern(std::string_view id);
+		std::optional<ModId> find(std::string_view id) const;
+
+		const std::string& string(ModId id) const;
+
+		size_t size() const;
+
+	private:
+		mutable std::shared_mutex                   _mutex;
+		std::deque<std::string>                     _strings;
+		std::unordered_map<std::string_view, ModId> _ids;
+	};
+}
+
+template <>
+struct std::hash<mm::ModId>
+{
+	size_t operator()(const mm::ModId& id) const noexcept
+	{
+		return std::hash<std::uint32_t>()(id.value);
+	}
+};
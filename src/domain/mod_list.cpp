@@ -1,6 +1,6 @@
 // SD Mod Manager
 
-// Copyright (c) 2020-2024 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Copyright (c) 2020-2026 Aliaksei Karalenka <sydr1991@gmail.com>.
 // Licensed under the MIT License <http://opensource.org/licenses/MIT>.
 
 #include "stdafx.h"
@@ -13,25 +13,76 @@
 
 using namespace mm;
 
-ModList::ModList(const std::vector<std::string>& active)
+ModList::ModList()
+	: ModList(std::make_shared<ModIdTable>())
+{}
+
+ModList::ModList(std::shared_ptr<ModIdTable> ids)
+	: ids(std::move(ids))
+{
+	MM_PRECONDTION(this->ids);
+}
+
+ModList::ModList(const std::vector<std::string>& active, std::shared_ptr<ModIdTable> ids)
+	: ModList(std::move(ids))
+{
+	// each id may occupy only one position, so repeated entries of hand edited list are skipped
+	for (const auto& item : active)
+		if (const auto id = this->ids->intern(item); !managed(id))
+			add(id, ModState::enabled);
+}
+
+const std::string& ModList::string(ModId id) const
+{
+	return ids->string(id);
+}
+
+const std::vector<ModList::Mod>& ModList::data() const
 {
-	for (const auto& id : active)
-		data.emplace_back(id, ModState::enabled);
+	return _data;
+}
+
+const std::set<ModId>& ModList::rest() const
+{
+	return _rest;
+}
+
+void ModList::add(ModId id, ModState state)
+{
+	MM_PRECONDTION(!managed(id));
+
+	insert(_data.size(), Mod { id, state });
+}
+
+void ModList::addArchived(ModId id)
+{
+	MM_PRECONDTION(!managed(id));
+
+	_rest.emplace(id);
+}
+
+bool ModList::managed(ModId id) const
+{
+	return position(id).has_value();
 }
 
 bool ModList::managed(const std::string& id) const
 {
-	auto it = std::find_if(data.cbegin(), data.cend(), [&](const Mod& m) { return m.id == id; });
+	return position(id).has_value();
+}
+
+std::optional<size_t> ModList::position(ModId id) const
+{
+	if (id.value < _positions.size() && _positions[id.value] != npos)
+		return _positions[id.value];
 
-	return it != data.cend();
+	return {};
 }
 
 std::optional<size_t> ModList::position(const std::string& id) const
 {
-	auto it = std::find_if(data.cbegin(), data.cend(), [&](const Mod& m) { return m.id == id; });
-
-	if (it != data.cend())
-		return std::distance(data.cbegin(), it);
+	if (auto modId = ids->find(id))
+		return position(*modId);
 
 	return {};
 }
@@ -43,16 +94,24 @@ std::string ModList::next(const std::string& id) const
 		if (!pos)
 			return 0u;
 
-		return pos == data.size() - 1 ? *pos - 1 : *pos + 1;
+		return pos == _data.size() - 1 ? *pos - 1 : *pos + 1;
 	}();
 
-	return position >= data.size() ? "" : data[position].id;
+	return position >= _data.size() ? "" : string(_data[position].id);
+}
+
+std::optional<ModList::ModState> ModList::state(ModId id) const
+{
+	if (auto pos = position(id))
+		return _data[*pos].state;
+
+	return {};
 }
 
 std::optional<ModList::ModState> ModList::state(const std::string& id) const
 {
 	if (auto pos = position(id))
-		return data[*pos].state;
+		return _data[*pos].state;
 
 	return {};
 }
@@ -75,47 +134,61 @@ std::vector<std::string> ModList::enabled() const
 {
 	std::vector<std::string> result;
 
-	for (const auto& item : data)
+	for (const auto& item : _data)
 		if (item.state == ModState::enabled)
-			result.emplace_back(item.id);
+			result.emplace_back(string(item.id));
 
 	return result;
 }
 
-void ModList::enable(const std::string& id)
+void ModList::enable(ModId id)
 {
 	const auto pos = position(id);
 	if (!pos)
 	{
-		data.emplace(data.begin() + 0, Mod { id, ModState::enabled });
-		rest.erase(id);
+		insert(0, Mod { id, ModState::enabled });
 		return;
 	}
 
-	data[*pos].state = ModState::enabled;
+	_data[*pos].state = ModState::enabled;
 }
 
-void ModList::enable(const std::string& id, size_t at)
+void ModList::enable(const std::string& id)
+{
+	enable(ids->intern(id));
+}
+
+void ModList::enable(ModId id, size_t at)
 {
 	const auto pos = position(id);
 	if (!pos)
 	{
-		data.emplace(data.begin() + at, Mod { id, ModState::enabled });
-		rest.erase(id);
+		insert(at, Mod { id, ModState::enabled });
 		return;
 	}
 
 	if (*pos != at)
 		move(*pos, at);
 
-	data[at].state = ModState::enabled;
+	_data[at].state = ModState::enabled;
 }
 
-void ModList::disable(const std::string& id)
+void ModList::enable(const std::string& id, size_t at)
+{
+	enable(ids->intern(id), at);
+}
+
+void ModList::disable(ModId id)
 {
 	const auto pos = position(id);
 	if (pos)
-		data[*pos].state = ModState::disabled;
+		_data[*pos].state = ModState::disabled;
+}
+
+void ModList::disable(const std::string& id)
+{
+	if (auto modId = ids->find(id))
+		disable(*modId);
 }
 
 void ModList::switchState(const std::string& id)
@@ -136,10 +209,12 @@ bool ModList::canMove(const std::string& from, const std::string& to) const
 
 void ModList::move(size_t from, size_t to)
 {
-	auto item = data[from];
+	auto item = _data[from];
+
+	_data.erase(_data.begin() + from);
+	_data.emplace(_data.begin() + to, item);
 
-	data.erase(data.begin() + from);
-	data.emplace(data.begin() + to, item);
+	reindex(std::min(from, to), std::max(from, to) + 1);
 }
 
 void ModList::move(const std::string& from, const std::string& to)
@@ -176,64 +251,77 @@ bool ModList::canMoveUp(const std::string& id) const
 void ModList::moveUp(const std::string& id)
 {
 	auto posFrom = position(id);
-	std::swap(data[*posFrom], data[*posFrom - 1]);
+	std::swap(_data[*posFrom], _data[*posFrom - 1]);
+	reindex(*posFrom - 1, *posFrom + 1);
 }
 
 bool ModList::canMoveDown(const std::string& id) const
 {
 	auto pos = position(id);
 
-	return pos && (*pos + 1 < data.size());
+	return pos && (*pos + 1 < _data.size());
 }
 
 void ModList::moveDown(const std::string& id)
 {
 	auto posFrom = position(id);
-	std::swap(data[*posFrom], data[*posFrom + 1]);
+	std::swap(_data[*posFrom], _data[*posFrom + 1]);
+	reindex(*posFrom, *posFrom + 2);
 }
 
-void ModList::archive(const std::string& id)
+void ModList::archive(ModId id)
 {
 	const auto pos = position(id);
 	if (!pos)
 		return;
 
-	rest.emplace(data[*pos].id);
-	data.erase(data.begin() + *pos);
+	_rest.emplace(id);
+	erase(*pos);
 }
 
-void ModList::apply(const std::vector<std::string>& ids, bool archiveOnDisable)
+void ModList::archive(const std::string& id)
 {
-	const std::unordered_set<std::string> active(ids.cbegin(), ids.cend());
+	if (auto modId = ids->find(id))
+		archive(*modId);
+}
+
+void ModList::apply(const std::vector<std::string>& items, bool archiveOnDisable)
+{
+	std::vector<ModId> interned;
+	interned.reserve(items.size());
+	for (const auto& item : items)
+		interned.emplace_back(ids->intern(item));
+
+	const std::unordered_set<ModId> active(interned.cbegin(), interned.cend());
 
 	size_t i    = 0;
 	size_t skip = 0;
 
-	std::unordered_set<std::string> toArchive;
+	std::unordered_set<ModId> toArchive;
 
-	while (i < ids.size())
+	while (i < interned.size())
 	{
-		const auto& id = ids[i];
+		const auto id = interned[i];
 
-		if (data.size() <= i + skip)
+		if (_data.size() <= i + skip)
 		{
 			enable(id, i + skip);
 			++i;
 		}
-		else if (!active.count(data[i + skip].id))
+		else if (!active.count(_data[i + skip].id))
 		{
 			if (archiveOnDisable)
-				toArchive.emplace(data[i + skip].id);
+				toArchive.emplace(_data[i + skip].id);
 
-			disable(data[i + skip].id);
+			disable(_data[i + skip].id);
 			++skip;
 		}
-		else if (id != data[i + skip].id)
+		else if (id != _data[i + skip].id)
 		{
 			enable(id, i + skip);
 			++i;
 		}
-		else if (data[i + skip].state != ModList::ModState::enabled)
+		else if (_data[i + skip].state != ModList::ModState::enabled)
 		{
 			enable(id, i + skip);
 			++i;
@@ -244,12 +332,12 @@ void ModList::apply(const std::vector<std::string>& ids, bool archiveOnDisable)
 		}
 	}
 
-	while (i + skip < data.size())
+	while (i + skip < _data.size())
 	{
 		if (archiveOnDisable)
-			toArchive.emplace(data[i + skip].id);
+			toArchive.emplace(_data[i + skip].id);
 
-		disable(data[i + skip].id);
+		disable(_data[i + skip].id);
 		++skip;
 	}
 
@@ -259,6 +347,43 @@ void ModList::apply(const std::vector<std::string>& ids, bool archiveOnDisable)
 
 void ModList::remove(const std::string& id)
 {
-	archive(id);
-	rest.erase(id);
+	if (auto modId = ids->find(id))
+	{
+		archive(*modId);
+		_rest.erase(*modId);
+	}
+}
+
+bool ModList::operator==(const ModList& other) const
+{
+	return _data == other._data && _rest == other._rest;
+}
+
+void ModList::insert(size_t at, Mod mod)
+{
+	_rest.erase(mod.id);
+	_data.emplace(_data.begin() + at, mod);
+
+	reindex(at, _data.size());
+}
+
+void ModList::erase(size_t at)
+{
+	_positions[_data[at].id.value] = npos;
+	_data.erase(_data.begin() + at);
+
+	reindex(at, _data.size());
+}
+
+void ModList::reindex(size_t from, size_t to)
+{
+	for (size_t i = from; i < to; ++i)
+	{
+		const auto value = _data[i].id.value;
+
+		if (value >= _positions.size())
+			_positions.resize(value + 1, npos);
+
+		_positions[value] = i;
+	}
 }
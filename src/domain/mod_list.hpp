@@ -1,13 +1,17 @@
 // SD Mod Manager
 
-// Copyright (c) 2020-2024 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Copyright (c) 2020-2026 Aliaksei Karalenka <sydr1991@gmail.com>.
 // Licensed under the MIT License <http://opensource.org/licenses/MIT>.
 
 #pragma once
 
+#include "mod_id.hpp"
+
 #include <compare>
+#include <memory>
 #include <optional>
 #include <set>
+#include <string>
 #include <vector>
 
 namespace mm
@@ -22,51 +26,57 @@ namespace mm
 
 		struct Mod
 		{
-			std::string id;
-			ModState    state = ModState::enabled;
+			ModId    id;
+			ModState state = ModState::enabled;
 
 			Mod() = default;
 
-			Mod(const std::string& id, ModState state)
+			Mod(ModId id, ModState state)
 				: id(id)
 				, state(state) {};
 
 			std::weak_ordering operator<=>(const Mod& other) const = default;
-
-			std::string to_string() const
-			{
-				switch (state)
-				{
-				case ModState::disabled: return '*' + id;
-				default: break;
-				}
-				return id;
-			}
 		};
 
-		std::vector<Mod>      data;
-		std::set<std::string> rest;
+		std::shared_ptr<ModIdTable> ids;
+
+		ModList();
+		explicit ModList(std::shared_ptr<ModIdTable> ids);
+		// duplicated ids in active are dropped, first occurrence keeps its position
+		ModList(const std::vector<std::string>& active, std::shared_ptr<ModIdTable> ids);
+
+		const std::string& string(ModId id) const;
 
-		ModList() = default;
-		explicit ModList(const std::vector<std::string>& active);
+		const std::vector<Mod>& data() const;
+		const std::set<ModId>&  rest() const;
 
+		void add(ModId id, ModState state);  // appends to the end of managed list
+		void addArchived(ModId id);
+
+		bool managed(ModId id) const;
 		bool managed(const std::string& id) const;
 
+		std::optional<size_t> position(ModId id) const;
 		std::optional<size_t> position(const std::string& id) const;
 		std::string           next(const std::string& id) const;
 
+		std::optional<ModState>  state(ModId id) const;
 		std::optional<ModState>  state(const std::string& id) const;
 		bool                     enabled(const std::string& id) const;
 		bool                     disabled(const std::string& id) const;
 
 		std::vector<std::string> enabled() const;
 
+		void enable(ModId id);
 		void enable(const std::string& id);
+		void enable(ModId id, size_t at);
 		void enable(const std::string& id, size_t at);
+		void disable(ModId id);
 		void disable(const std::string& id);
+		void archive(ModId id);
 		void archive(const std::string& id);
 
-		void apply(const std::vector<std::string>& ids, bool archiveOnDisable);
+		void apply(const std::vector<std::string>& items, bool archiveOnDisable);
 
 		void switchState(const std::string& id);
 
@@ -81,6 +91,19 @@ namespace mm
 
 		void remove(const std::string& id);
 
-		std::weak_ordering operator<=>(const ModList& other) const = default;
+		// lists are expected to share same id table
+		bool operator==(const ModList& other) const;
+
+	private:
+		void insert(size_t at, Mod mod);
+		void erase(size_t at);
+		void reindex(size_t from, size_t to);
+
+	private:
+		static constexpr size_t npos = static_cast<size_t>(-1);
+
+		std::vector<Mod>    _data;
+		std::set<ModId>     _rest;
+		std::vector<size_t> _positions;  // ModId::value -> index in _data, npos if not managed
 	};
 }
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "mod_id.hpp"
 #include "type/filesystem.hpp"
 
 #include <set>
@@ -27,8 +28,8 @@ namespace mm
 
 		int priority = 0;
 
-		std::set<std::string> incompatible;
-		std::set<std::string> requires_;
-		std::set<std::string> load_after;
+		std::set<ModId> incompatible;
+		std::set<ModId> requires_;
+		std::set<ModId> load_after;
 	};
 }
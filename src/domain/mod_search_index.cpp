@@ -0,0 +1,113 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#include "stdafx.h"
+
+#include "mod_search_index.hpp"
+
+#include "utility/fs_util.h"
+
+#include <boost/locale/conversion.hpp>
+
+using namespace mm;
+
+namespace
+{
+	// fields are stored one after another, separator can't be a part of query
+	constexpr char FieldSeparator = '\0';
+
+	std::uint32_t trigram(std::string_view text, size_t at)
+	{
+		const auto byte = [&](size_t i) { return static_cast<std::uint32_t>(static_cast<std::uint8_t>(text[i])); };
+
+		return byte(at) | byte(at + 1) << 8 | byte(at + 2) << 16;
+	}
+}
+
+ModSearchIndex::ModSearchIndex(const std::vector<Source>& sources, std::stop_token token)
+{
+	_ids.reserve(sources.size());
+	_texts.reserve(sources.size());
+
+	for (const auto& source : sources)
+	{
+		if (token.stop_requested())
+			return;
+
+		std::string text;
+		for (const auto& field : source.fields)
+		{
+			text += boost::locale::fold_case(field);
+			text += FieldSeparator;
+		}
+
+		text += boost::locale::fold_case(readFile(source.description));
+
+		const auto index = static_cast<std::uint32_t>(_texts.size());
+		for (size_t i = 0; i + 3 <= text.size(); ++i)
+		{
+			const std::string_view part(text.data() + i, 3);
+			if (part.find(FieldSeparator) != std::string_view::npos)
+				continue;
+
+			auto& postings = _trigrams[trigram(part, 0)];
+			if (postings.empty() || postings.back() != index)
+				postings.emplace_back(index);
+		}
+
+		_ids.emplace_back(source.id);
+		_texts.emplace_back(std::move(text));
+		_indexed.emplace(source.id);
+	}
+}
+
+bool ModSearchIndex::contains(const std::string& id) const
+{
+	return _indexed.contains(id);
+}
+
+std::unordered_set<std::string> ModSearchIndex::find(std::string_view query) const
+{
+	std::unordered_set<std::string> result;
+
+	auto check = [&](std::uint32_t index) {
+		if (_texts[index].find(query) != std::string::npos)
+			result.emplace(_ids[index]);
+	};
+
+	if (query.size() < 3)
+	{
+		for (std::uint32_t i = 0; i < _texts.size(); ++i)
+			check(i);
+
+		return result;
+	}
+
+	std::vector<const std::vector<std::uint32_t>*> lists;
+	for (size_t i = 0; i + 3 <= query.size(); ++i)
+	{
+		auto it = _trigrams.find(trigram(query, i));
+		if (it == _trigrams.cend())
+			return result;
+
+		lists.emplace_back(&it->second);
+	}
+
+	std::ranges::sort(lists, {}, [](const auto* list) { return list->size(); });
+
+	std::vector<std::uint32_t> candidates = *lists.front();
+	std::vector<std::uint32_t> intersection;
+	for (auto it = std::next(lists.cbegin()); it != lists.cend() && !candidates.empty(); ++it)
+	{
+		intersection.clear();
+		std::ranges::set_intersection(candidates, **it, std::back_inserter(intersection));
+		candidates.swap(intersection);
+	}
+
+	for (const auto index : candidates)
+		check(index);
+
+	return result;
+}
@@ -0,0 +1,43 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "type/filesystem.hpp"
+
+#include <cstdint>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace mm
+{
+	// Trigram index over case folded text of mods, used by mod list filter
+	struct ModSearchIndex
+	{
+		struct Source
+		{
+			std::string              id;
+			std::vector<std::string> fields;
+			fs::path                 description;  // file, content of which is indexed as well
+		};
+
+		explicit ModSearchIndex(const std::vector<Source>& sources, std::stop_token token = {});
+
+		bool contains(const std::string& id) const;
+
+		// returns mods, which have query as a substring of any field; query must be already folded
+		std::unordered_set<std::string> find(std::string_view query) const;
+
+	private:
+		std::vector<std::string>                                      _ids;
+		std::vector<std::string>                                      _texts;
+		std::unordered_set<std::string>                               _indexed;
+		std::unordered_map<std::uint32_t, std::vector<std::uint32_t>> _trigrams;
+	};
+}
@@ -0,0 +1,159 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#include "stdafx.h"
+
+#include "era2_archive_reader.hpp"
+
+#include <boost/algorithm/string.hpp>
+
+#include <array>
+#include <cstring>
+
+using namespace mm;
+
+namespace
+{
+	enum class Format
+	{
+		unknown,
+		lod,  // "LOD\0", type, count, 80 unused bytes, then 32 byte entries:
+		      // name[16], offset, size, type, packed size (0 if not packed)
+		snd,  // count, then 48 byte entries: name[40] ("name\0ext"), offset, size
+		vid,  // count, then 44 byte entries: name[40], offset; size is distance to next file
+	};
+
+	Format formatOfExtension(std::string_view extension)
+	{
+		if (extension == ".lod" || extension == ".pac")
+			return Format::lod;
+		if (extension == ".snd")
+			return Format::snd;
+		if (extension == ".vid")
+			return Format::vid;
+
+		return Format::unknown;
+	}
+
+	Format formatOf(const fs::path& path)
+	{
+		return formatOfExtension(boost::to_lower_copy(path.extension().string()));
+	}
+
+	std::uint32_t readUInt32(const char* data)
+	{
+		std::uint32_t result = 0;
+		std::memcpy(&result, data, sizeof(result));
+
+		return result;
+	}
+
+	std::string readName(const char* data, size_t size)
+	{
+		return std::string(data, strnlen(data, size));
+	}
+
+	// extension is stored after terminating zero, some localized versions don't have it at all
+	std::string readSndName(const char* data, size_t size)
+	{
+		auto result = readName(data, size);
+
+		if (result.size() + 1 < size && data[result.size() + 1] != '\0')
+			result += '.' + readName(data + result.size() + 1, std::min<size_t>(3, size - result.size() - 1));
+		else
+			result += ".wav";
+
+		return result;
+	}
+}
+
+bool Era2ArchiveReader::isArchive(const fs::path& path)
+{
+	return formatOf(path) != Format::unknown;
+}
+
+bool Era2ArchiveReader::isArchiveExtension(std::string_view extension)
+{
+	return formatOfExtension(extension) != Format::unknown;
+}
+
+std::optional<std::vector<Era2ArchiveEntry>> Era2ArchiveReader::read(const fs::path& path)
+{
+	const auto format = formatOf(path);
+	if (format == Format::unknown)
+		return std::vector<Era2ArchiveEntry>();
+
+	boost::system::error_code ec;
+	const auto                fileSize = file_size(path, ec);
+	if (ec)
+		return {};
+
+	boost::nowide::ifstream file(path, std::ios_base::in | std::ios_base::binary);
+
+	const size_t headerSize = format == Format::lod ? 92 : 4;
+	const size_t entrySize  = format == Format::lod ? 32 : format == Format::snd ? 48 : 44;
+
+	std::array<char, 92> header = {};
+	if (!file.read(header.data(), headerSize))
+		return {};
+
+	if (format == Format::lod && std::memcmp(header.data(), "LOD\0", 4) != 0)
+		return {};
+
+	const size_t count = readUInt32(header.data() + (format == Format::lod ? 8 : 0));
+	if (count > (fileSize - headerSize) / entrySize)
+		return {};
+
+	std::vector<char> table(count * entrySize);
+	if (!file.read(table.data(), table.size()))
+		return {};
+
+	std::vector<Era2ArchiveEntry> result(count);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const char* data  = table.data() + i * entrySize;
+		auto&       entry = result[i];
+
+		switch (format)
+		{
+		case Format::lod:
+			entry.name       = readName(data, 16);
+			entry.offset     = readUInt32(data + 16);
+			entry.size       = readUInt32(data + 20);
+			entry.packedSize = readUInt32(data + 28);
+			entry.compressed = entry.packedSize != 0;
+			break;
+		case Format::snd:
+			entry.name   = readSndName(data, 40);
+			entry.offset = readUInt32(data + 40);
+			entry.size   = readUInt32(data + 44);
+			break;
+		case Format::vid:
+			entry.name   = readName(data, 40);
+			entry.offset = readUInt32(data + 40);
+			break;
+		case Format::unknown: break;
+		}
+	}
+
+	if (format == Format::vid)
+	{
+		std::vector<std::uint32_t> offsets;
+		for (const auto& entry : result)
+			offsets.emplace_back(entry.offset);
+
+		offsets.emplace_back(static_cast<std::uint32_t>(fileSize));
+		std::ranges::sort(offsets);
+
+		for (auto& entry : result)
+		{
+			const auto next = std::ranges::upper_bound(offsets, entry.offset);
+			entry.size      = next != offsets.cend() ? *next - entry.offset : 0;
+		}
+	}
+
+	return result;
+}
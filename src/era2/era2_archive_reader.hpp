@@ -0,0 +1,42 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "type/filesystem.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mm
+{
+	struct Era2ArchiveEntry
+	{
+		std::string   name;
+		std::uint32_t offset     = 0;
+		std::uint32_t size       = 0;  // unpacked size
+		std::uint32_t packedSize = 0;  // size in archive, if compressed
+		bool          compressed = false;
+
+		std::uint32_t storedSize() const
+		{
+			return compressed ? packedSize : size;
+		}
+	};
+}
+
+namespace mm::Era2ArchiveReader
+{
+	// .lod and .pac share lod format, .snd and .vid have own ones
+	bool isArchive(const fs::path& path);
+	bool isArchiveExtension(std::string_view extension);  // lower case, with dot
+
+	// Reads entry table of archive at once. Returns empty table for unknown format
+	// and nothing if archive can't be read (locked, truncated or malformed)
+	std::optional<std::vector<Era2ArchiveEntry>> read(const fs::path& path);
+}
@@ -55,6 +55,7 @@ void Era2Config::createDirectories() const
 {
 	create_directories(getProgramDataPath());
 	create_directories(getPresetsPath());
+	create_directories(getCachePath());
 	// create_directories(getTempPath());
 }
 
@@ -83,6 +84,11 @@ fs::path Era2Config::getTempPath() const
 	return getProgramDataPath() / "Temp";
 }
 
+fs::path Era2Config::getCachePath() const
+{
+	return getProgramDataPath() / "Cache";
+}
+
 fs::path Era2Config::getConfigFilePath() const
 {
 	return getProgramDataPath() / "config.json";
@@ -21,6 +21,7 @@ namespace mm
 
 		fs::path getDataPath() const override;
 		fs::path getTempPath() const override;
+		fs::path getCachePath() const override;
 
 		fs::path getProgramDataPath() const;
 		fs::path getPresetsPath() const;
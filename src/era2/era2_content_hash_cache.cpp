@@ -0,0 +1,129 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#include "stdafx.h"
+
+#include "era2_content_hash_cache.hpp"
+
+#include "system_info.hpp"
+#include "utility/binary_stream.hpp"
+
+using namespace mm;
+
+namespace
+{
+	constexpr std::string_view Signature     = "SDMMHASH";
+	constexpr std::uint32_t    FormatVersion = 1;
+}
+
+Era2ContentHashCache::Era2ContentHashCache(fs::path path)
+	: _path(std::move(path))
+{
+	load();
+}
+
+Era2ContentHashCache::File Era2ContentHashCache::take(const fs::path& path, const FileStamp& stamp)
+{
+	File result;
+
+	{
+		std::lock_guard lock(_mutex);
+
+		if (auto it = _files.find(path.string()); it != _files.end())
+		{
+			result = std::move(it->second);
+			_files.erase(it);
+		}
+	}
+
+	if (result.stamp != stamp)
+	{
+		result.stamp = stamp;
+		result.hashes.clear();
+	}
+
+	return result;
+}
+
+void Era2ContentHashCache::store(const fs::path& path, File file)
+{
+	std::lock_guard lock(_mutex);
+
+	_files.insert_or_assign(path.string(), std::move(file));
+}
+
+void Era2ContentHashCache::save()
+{
+	std::lock_guard lock(_mutex);
+
+	std::erase_if(_files, [](const auto& item) {
+		boost::system::error_code ec;
+		return !is_regular_file(fs::path(item.first), ec);
+	});
+
+	BinaryWriter writer;
+	writer.buffer.append(Signature);
+	writer.write(FormatVersion);
+	writer.write(std::string_view(SystemInfo::ProgramVersion));
+	writer.write(static_cast<std::uint32_t>(_files.size()));
+
+	for (const auto& [path, file] : _files)
+	{
+		writer.write(path);
+		writer.writeStamp(file.stamp);
+		writer.write(static_cast<std::uint32_t>(file.hashes.size()));
+
+		for (const auto& [offset, hash] : file.hashes)
+		{
+			writer.write(offset);
+			writer.buffer.append(reinterpret_cast<const char*>(hash.data()), hash.size());
+		}
+	}
+
+	overwriteFile(_path, writer.buffer);
+}
+
+void Era2ContentHashCache::load()
+{
+	boost::nowide::ifstream file(_path, std::ios_base::in | std::ios_base::binary);
+	if (!file)
+		return;
+
+	std::stringstream content;
+	content << file.rdbuf();
+
+	const auto   buffer = content.str();
+	BinaryReader reader { buffer };
+
+	try
+	{
+		if (reader.take(Signature.size()) != Signature || reader.read<std::uint32_t>() != FormatVersion ||
+			reader.readString() != SystemInfo::ProgramVersion)
+			return;
+
+		for (auto size = reader.read<std::uint32_t>(); size > 0; --size)
+		{
+			auto path = reader.readString();
+
+			File item;
+			item.stamp = reader.readStamp();
+
+			for (auto hashes = reader.read<std::uint32_t>(); hashes > 0; --hashes)
+			{
+				const auto offset = reader.read<std::uint32_t>();
+				const auto bytes  = reader.take(std::tuple_size_v<ContentHash>);
+
+				auto& hash = item.hashes[offset];
+				std::memcpy(hash.data(), bytes.data(), hash.size());
+			}
+
+			_files.insert_or_assign(std::move(path), std::move(item));
+		}
+	}
+	catch (const corrupted_cache_error&)
+	{
+		_files.clear();
+	}
+}
@@ -0,0 +1,51 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "type/filesystem.hpp"
+#include "utility/fs_util.h"
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace mm
+{
+	using ContentHash = std::array<std::uint8_t, 16>;  // md5
+
+	// Keeps content hashes of files between program runs.
+	// Hashes of file are valid while it has same size and modification time
+	struct Era2ContentHashCache
+	{
+		static constexpr auto WholeFile = std::uint32_t(-1);
+
+		struct File
+		{
+			FileStamp                                      stamp;
+			std::unordered_map<std::uint32_t, ContentHash> hashes;  // [offset of archive entry] -> hash
+		};
+
+		explicit Era2ContentHashCache(fs::path path);
+
+		// safe to call from multiple threads, hashes are dropped if file was changed
+		File take(const fs::path& path, const FileStamp& stamp);
+		void store(const fs::path& path, File file);
+
+		// hashes of files, which don't exist anymore, are dropped
+		void save();
+
+	private:
+		void load();
+
+	private:
+		const fs::path _path;
+
+		std::mutex                            _mutex;
+		std::unordered_map<std::string, File> _files;  // [path] -> hashes
+	};
+}
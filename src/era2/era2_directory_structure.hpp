@@ -1,28 +1,36 @@
 // SD Mod Manager
 
-// Copyright (c) 2020 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Copyright (c) 2020-2026 Aliaksei Karalenka <sydr1991@gmail.com>.
 // Licensed under the MIT License <http://opensource.org/licenses/MIT>.
 
 #pragma once
 
-#include "type/filesystem.hpp"
-
-#include <map>
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
 
 namespace mm
 {
+	// physical file, providing virtual one
+	struct Era2FileOwner
+	{
+		std::uint32_t mod      = 0;      // index in Era2DirectoryStructure::mods
+		std::uint32_t path     = 0;      // index in Era2DirectoryStructure::paths, relative to base path
+		bool          archived = false;  // path is archive, containing file
+	};
+
 	struct Era2FileEntry
 	{
-		fs::path                 filePath;  // virtual file path
-		std::string              gamePath;  // path to file in game, if available
-		std::vector<std::string> modPaths;
+		std::uint32_t                filePath = 0;  // virtual file path, index in paths
+		std::optional<std::uint32_t> gamePath;      // path to file in game, if available
+		std::vector<Era2FileOwner>   owners;        // ordered by mod
 	};
 
 	struct Era2DirectoryStructure
 	{
 		std::vector<std::string>   mods;
+		std::vector<std::string>   paths;  // every path is stored once, entries refer to them by index
 		std::vector<Era2FileEntry> entries;
 	};
 }
@@ -0,0 +1,171 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#include "stdafx.h"
+
+#include "era2_file_manifest_cache.hpp"
+
+#include "system_info.hpp"
+#include "utility/binary_stream.hpp"
+
+using namespace mm;
+
+namespace
+{
+	constexpr std::string_view Signature     = "SDMMFILE";
+	constexpr std::uint32_t    FormatVersion = 2;
+
+	void writeManifest(BinaryWriter& writer, const Era2FileManifest& manifest)
+	{
+		writer.write(static_cast<std::uint32_t>(manifest.directories.size()));
+		for (const auto& [path, stamp] : manifest.directories)
+		{
+			writer.writePath(path);
+			writer.writeStamp(stamp);
+		}
+
+		writer.write(static_cast<std::uint32_t>(manifest.files.size()));
+		for (const auto& file : manifest.files)
+		{
+			writer.writePath(file.relative);
+			writer.write(static_cast<std::uint64_t>(file.archive));
+		}
+
+		writer.write(static_cast<std::uint32_t>(manifest.archives.size()));
+		for (const auto& archive : manifest.archives)
+		{
+			writer.writeStamp(archive.stamp);
+			writer.write(static_cast<std::uint32_t>(archive.entries.size()));
+
+			for (const auto& entry : archive.entries)
+			{
+				writer.write(entry.name);
+				writer.write(entry.offset);
+				writer.write(entry.size);
+				writer.write(entry.packedSize);
+				writer.write(entry.compressed);
+			}
+		}
+	}
+
+	Era2FileManifest readManifest(BinaryReader& reader)
+	{
+		Era2FileManifest result;
+
+		for (auto size = reader.read<std::uint32_t>(); size > 0; --size)
+		{
+			auto path  = reader.readPath();
+			auto stamp = reader.readStamp();
+
+			result.directories.emplace_back(std::move(path), stamp);
+		}
+
+		for (auto size = reader.read<std::uint32_t>(); size > 0; --size)
+		{
+			auto& file    = result.files.emplace_back();
+			file.relative = reader.readPath();
+			file.archive  = static_cast<size_t>(reader.read<std::uint64_t>());
+		}
+
+		for (auto size = reader.read<std::uint32_t>(); size > 0; --size)
+		{
+			auto& archive = result.archives.emplace_back();
+			archive.stamp = reader.readStamp();
+
+			for (auto entries = reader.read<std::uint32_t>(); entries > 0; --entries)
+			{
+				auto& entry      = archive.entries.emplace_back();
+				entry.name       = reader.readString();
+				entry.offset     = reader.read<std::uint32_t>();
+				entry.size       = reader.read<std::uint32_t>();
+				entry.packedSize = reader.read<std::uint32_t>();
+				entry.compressed = reader.read<bool>();
+			}
+		}
+
+		for (const auto& file : result.files)
+			if (file.archive != size_t(-1) && file.archive >= result.archives.size())
+				throw corrupted_cache_error("archive index is out of range");
+
+		return result;
+	}
+}
+
+Era2FileManifestCache::Era2FileManifestCache(fs::path path)
+	: _path(std::move(path))
+{
+	load();
+}
+
+std::optional<Era2FileManifest> Era2FileManifestCache::take(const fs::path& root)
+{
+	auto it = _entries.find(root.string());
+	if (it == _entries.end())
+		return {};
+
+	auto result = std::move(it->second);
+	_entries.erase(it);
+
+	return result;
+}
+
+void Era2FileManifestCache::store(const fs::path& root, Era2FileManifest manifest)
+{
+	_entries.insert_or_assign(root.string(), std::move(manifest));
+}
+
+void Era2FileManifestCache::save()
+{
+	std::erase_if(_entries, [](const auto& item) {
+		boost::system::error_code ec;
+		return !is_directory(fs::path(item.first), ec);
+	});
+
+	BinaryWriter writer;
+	writer.buffer.append(Signature);
+	writer.write(FormatVersion);
+	writer.write(std::string_view(SystemInfo::ProgramVersion));
+	writer.write(static_cast<std::uint32_t>(_entries.size()));
+
+	for (const auto& [root, manifest] : _entries)
+	{
+		writer.write(root);
+		writeManifest(writer, manifest);
+	}
+
+	overwriteFile(_path, writer.buffer);
+}
+
+void Era2FileManifestCache::load()
+{
+	boost::nowide::ifstream file(_path, std::ios_base::in | std::ios_base::binary);
+	if (!file)
+		return;
+
+	std::stringstream content;
+	content << file.rdbuf();
+
+	const auto   buffer = content.str();
+	BinaryReader reader { buffer };
+
+	try
+	{
+		if (reader.take(Signature.size()) != Signature || reader.read<std::uint32_t>() != FormatVersion ||
+			reader.readString() != SystemInfo::ProgramVersion)
+			return;
+
+		for (auto size = reader.read<std::uint32_t>(); size > 0; --size)
+		{
+			auto root     = reader.readString();
+			auto manifest = readManifest(reader);
+
+			_entries.insert_or_assign(std::move(root), std::move(manifest));
+		}
+	}
+	catch (const corrupted_cache_error&)
+	{
+		_entries.clear();
+	}
+}
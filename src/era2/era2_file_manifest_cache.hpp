@@ -0,0 +1,63 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "era2_archive_reader.hpp"
+#include "type/filesystem.hpp"
+#include "utility/fs_util.h"
+
+#include <deque>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mm
+{
+	// Files of single directory tree (including entries of archives), paths are relative to it
+	struct Era2FileManifest
+	{
+		struct File
+		{
+			fs::path relative;
+			size_t   archive = size_t(-1);  // index in archives
+		};
+
+		struct Archive
+		{
+			FileStamp                     stamp;
+			std::vector<Era2ArchiveEntry> entries;
+		};
+
+		std::vector<std::pair<fs::path, FileStamp>> directories;  // every visited directory, root first
+		std::vector<File>                           files;        // in order of iteration
+		std::deque<Archive>                         archives;     // deque, so readers can keep references
+	};
+
+	// Keeps manifests of scanned directories between program runs.
+	// Listing is valid while every directory in it has same modification time,
+	// entries of archive are valid while archive has same size and modification time
+	struct Era2FileManifestCache
+	{
+		explicit Era2FileManifestCache(fs::path path);
+
+		// manifest is moved out of cache, store it back after it is updated
+		std::optional<Era2FileManifest> take(const fs::path& root);
+		void                            store(const fs::path& root, Era2FileManifest manifest);
+
+		// manifests of directories, which don't exist anymore, are dropped
+		void save();
+
+	private:
+		void load();
+
+	private:
+		const fs::path _path;
+
+		std::unordered_map<std::string, Era2FileManifest> _entries;  // [root] -> manifest
+	};
+}
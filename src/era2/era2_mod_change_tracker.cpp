@@ -0,0 +1,223 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#include "stdafx.h"
+
+#include "era2_mod_change_tracker.hpp"
+
+#include "system_info.hpp"
+
+#include <boost/locale/conversion.hpp>
+#include <wx/evtloop.h>
+#include <wx/fswatcher.h>
+
+using namespace mm;
+
+bool Era2ModChangeTracker::Changes::empty() const
+{
+	return !listChanged && !directoriesChanged && mods.empty();
+}
+
+Era2ModChangeTracker::Era2ModChangeTracker(fs::path modsPath, fs::path listPath)
+	: _modsPath(std::move(modsPath))
+	, _listPath(std::move(listPath))
+	, _list(fileStamp(_listPath))
+	, _mods(scan())
+{}
+
+Era2ModChangeTracker::~Era2ModChangeTracker() = default;
+
+Era2ModChangeTracker::Changes Era2ModChangeTracker::poll()
+{
+	// watcher can be created only when event loop is running
+	if (!_watcher && wxEventLoopBase::GetActive())
+		startWatching();
+
+	if (!_watcher || _touchedAll)
+		return checkAll();
+
+	return checkTouched();
+}
+
+void Era2ModChangeTracker::listSaved()
+{
+	_list = fileStamp(_listPath);
+}
+
+void Era2ModChangeTracker::startWatching()
+{
+	if (!is_directory(_modsPath))
+		return;
+
+	_eventHandler = std::make_unique<wxEvtHandler>();
+	_eventHandler->Bind(wxEVT_FSWATCHER, [=](wxFileSystemWatcherEvent& event) { onFileSystemEvent(event); });
+
+	_watcher = std::make_unique<wxFileSystemWatcher>();
+	_watcher->SetOwner(_eventHandler.get());
+
+	if (!_watcher->AddTree(wxFileName::DirName(wxString::FromUTF8(_modsPath.string()))))
+	{
+		_watcher.reset();
+		_eventHandler.reset();
+		return;
+	}
+
+	// we don't know what was changed before watcher was created
+	_touchedAll = true;
+}
+
+void Era2ModChangeTracker::onFileSystemEvent(const wxFileSystemWatcherEvent& event)
+{
+	switch (event.GetChangeType())
+	{
+	case wxFSW_EVENT_WARNING:
+	case wxFSW_EVENT_ERROR: _touchedAll = true; break;
+	case wxFSW_EVENT_RENAME:
+		touch(fs::path(event.GetPath().GetFullPath().utf8_string()), true);
+		touch(fs::path(event.GetNewPath().GetFullPath().utf8_string()), true);
+		break;
+	default: touch(fs::path(event.GetPath().GetFullPath().utf8_string()), false); break;
+	}
+}
+
+void Era2ModChangeTracker::touch(const fs::path& path, bool renamed)
+{
+	const auto relative = path.lexically_relative(_modsPath);
+	if (relative.empty() || *relative.begin() == "..")
+		return;
+
+	// mod directory itself was renamed, it can be just a change of case
+	if (renamed && std::next(relative.begin()) == relative.end())
+		_touchedAll = true;
+
+	_touched.emplace(boost::locale::fold_case(relative.begin()->string()));
+}
+
+std::unordered_map<std::string, Era2ModChangeTracker::ModStamp> Era2ModChangeTracker::scan() const
+{
+	std::unordered_map<std::string, ModStamp> result;
+
+	boost::system::error_code ec;
+	for (auto it = fs::directory_iterator(_modsPath, ec), end = fs::directory_iterator(); !ec && it != end;
+		 it.increment(ec))
+	{
+		if (!it->is_directory(ec))
+			continue;
+
+		result[boost::locale::fold_case(it->path().filename().string())] = stamp(it->path());
+	}
+
+	return result;
+}
+
+Era2ModChangeTracker::ModStamp Era2ModChangeTracker::stamp(const fs::path& dir) const
+{
+	ModStamp result;
+
+	boost::system::error_code ec;
+	result.dir     = dir.filename().string();
+	result.dirTime = last_write_time(dir, ec);
+	result.modInfo = fileStamp(dir / SystemInfo::ModInfoFilename);
+
+	return result;
+}
+
+Era2ModChangeTracker::Changes Era2ModChangeTracker::checkAll()
+{
+	Changes result;
+
+	_touchedAll = false;
+	_touched.clear();
+
+	if (auto list = fileStamp(_listPath); list != _list)
+	{
+		_list              = list;
+		result.listChanged = true;
+	}
+
+	auto mods = scan();
+
+	for (const auto& [id, stamp] : mods)
+	{
+		auto it = _mods.find(id);
+		if (it == _mods.cend() || it->second.dir != stamp.dir)
+			result.directoriesChanged = true;
+
+		if (it == _mods.cend() || it->second != stamp)
+			result.mods.emplace(id);
+	}
+
+	for (const auto& [id, stamp] : _mods)
+	{
+		if (!mods.contains(id))
+		{
+			result.directoriesChanged = true;
+			result.mods.emplace(id);
+		}
+	}
+
+	_mods = std::move(mods);
+
+	return result;
+}
+
+Era2ModChangeTracker::Changes Era2ModChangeTracker::checkTouched()
+{
+	Changes result;
+
+	const auto listName = boost::locale::fold_case(_listPath.filename().string());
+
+	for (const auto& name : std::exchange(_touched, {}))
+	{
+		if (name == listName)
+		{
+			if (auto list = fileStamp(_listPath); list != _list)
+			{
+				_list              = list;
+				result.listChanged = true;
+			}
+
+			continue;
+		}
+
+		auto it = _mods.find(name);
+
+		const auto path = _modsPath / (it != _mods.cend() ? it->second.dir : name);
+
+		boost::system::error_code ec;
+		if (!is_directory(path, ec))
+		{
+			// known mod was removed, it's simpler to look at whole directory
+			if (it != _mods.cend())
+				_touchedAll = true;
+
+			continue;
+		}
+
+		auto current = stamp(path);
+		if (it == _mods.cend())
+		{
+			result.directoriesChanged = true;
+			result.mods.emplace(name);
+			_mods.emplace(name, std::move(current));
+		}
+		else if (it->second != current)
+		{
+			result.mods.emplace(name);
+			it->second = std::move(current);
+		}
+	}
+
+	if (_touchedAll)
+	{
+		auto rest = checkAll();
+
+		result.listChanged |= rest.listChanged;
+		result.directoriesChanged |= rest.directoriesChanged;
+		result.mods.merge(rest.mods);
+	}
+
+	return result;
+}
@@ -0,0 +1,76 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "type/filesystem.hpp"
+#include "utility/fs_util.h"
+
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+
+class wxEvtHandler;
+class wxFileSystemWatcher;
+class wxFileSystemWatcherEvent;
+
+namespace mm
+{
+	// Detects what was changed in Mods directory since previous check.
+	// Uses file system watcher when it's available, otherwise compares modification stamps of everything.
+	struct Era2ModChangeTracker
+	{
+		struct Changes
+		{
+			bool                  listChanged        = false;  // list.txt was modified
+			bool                  directoriesChanged = false;  // mod directory was added, removed or renamed
+			std::set<std::string> mods;                        // mods which directory or mod.json was changed
+
+			bool empty() const;
+		};
+
+		Era2ModChangeTracker(fs::path modsPath, fs::path listPath);
+		~Era2ModChangeTracker();
+
+		Changes poll();
+
+		// list.txt was written by us, there is no need to report it
+		void listSaved();
+
+	private:
+		struct ModStamp
+		{
+			std::string dir;
+			std::time_t dirTime = 0;
+			FileStamp   modInfo;
+
+			bool operator==(const ModStamp&) const = default;
+		};
+
+		void startWatching();
+		void onFileSystemEvent(const wxFileSystemWatcherEvent& event);
+		void touch(const fs::path& path, bool renamed);
+
+		std::unordered_map<std::string, ModStamp> scan() const;
+		ModStamp                                  stamp(const fs::path& dir) const;
+
+		Changes checkAll();
+		Changes checkTouched();
+
+	private:
+		const fs::path _modsPath;
+		const fs::path _listPath;
+
+		FileStamp                                 _list;
+		std::unordered_map<std::string, ModStamp> _mods;
+
+		std::unique_ptr<wxEvtHandler>        _eventHandler;
+		std::unique_ptr<wxFileSystemWatcher> _watcher;
+
+		bool                  _touchedAll = true;
+		std::set<std::string> _touched;  // folded names of entries directly inside Mods directory
+	};
+}
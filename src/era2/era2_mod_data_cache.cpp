@@ -0,0 +1,183 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#include "stdafx.h"
+
+#include "era2_mod_data_cache.hpp"
+
+#include "system_info.hpp"
+#include "utility/binary_stream.hpp"
+
+using namespace mm;
+
+namespace
+{
+	constexpr std::string_view Signature     = "SDMMDATA";
+	constexpr std::uint32_t    FormatVersion = 2;
+
+	void writeModIds(BinaryWriter& writer, const std::set<ModId>& value, const ModIdTable& modIds)
+	{
+		writer.write(static_cast<std::uint32_t>(value.size()));
+		for (const auto& item : value)
+			writer.write(modIds.string(item));
+	}
+
+	std::set<ModId> readModIds(BinaryReader& reader, ModIdTable& modIds)
+	{
+		std::set<ModId> result;
+		for (auto size = reader.read<std::uint32_t>(); size > 0; --size)
+			result.emplace(modIds.intern(reader.readString()));
+
+		return result;
+	}
+
+	void writeModData(BinaryWriter& writer, const ModData& data, const ModIdTable& modIds)
+	{
+		writer.write(data.id);
+		writer.write(data.dir);
+		writer.writePath(data.data_path);
+		writer.write(data.virtual_mod);
+		writer.write(data.legacy_format);
+
+		writer.write(data.name);
+		writer.writePath(data.description);
+		writer.write(data.icon);
+		writer.write(data.author);
+		writer.write(data.homepage);
+		writer.writeStrings(data.support);
+		writer.write(data.category);
+		writer.write(data.version);
+		writer.write(static_cast<std::int32_t>(data.priority));
+		writeModIds(writer, data.incompatible, modIds);
+		writeModIds(writer, data.requires_, modIds);
+		writeModIds(writer, data.load_after, modIds);
+	}
+
+	ModData readModData(BinaryReader& reader, ModIdTable& modIds)
+	{
+		ModData result;
+		result.id            = reader.readString();
+		result.dir           = reader.readString();
+		result.data_path     = reader.readPath();
+		result.virtual_mod   = reader.read<bool>();
+		result.legacy_format = reader.read<bool>();
+
+		result.name         = reader.readString();
+		result.description  = reader.readPath();
+		result.icon         = reader.readString();
+		result.author       = reader.readString();
+		result.homepage     = reader.readString();
+		result.support      = reader.readStringList();
+		result.category     = reader.readString();
+		result.version      = reader.readString();
+		result.priority     = reader.read<std::int32_t>();
+		result.incompatible = readModIds(reader, modIds);
+		result.requires_    = readModIds(reader, modIds);
+		result.load_after   = readModIds(reader, modIds);
+
+		return result;
+	}
+}
+
+Era2ModDataCache::Era2ModDataCache(fs::path path, ModIdTable& modIds, std::string context)
+	: _path(std::move(path))
+	, _modIds(modIds)
+	, _context(std::string(SystemInfo::ProgramVersion) + '\n' + std::move(context))
+{
+	load();
+}
+
+std::optional<ModData> Era2ModDataCache::find(
+	const std::string& id, const fs::path& loadFrom, const Stamp& stamp)
+{
+	std::lock_guard lock(_mutex);
+
+	auto it = _entries.find(id);
+	if (it == _entries.end() || it->second.stamp != stamp || it->second.data.data_path != loadFrom)
+		return {};
+
+	it->second.requested = true;
+
+	return it->second.data;
+}
+
+void Era2ModDataCache::store(const ModData& data, const Stamp& stamp)
+{
+	std::lock_guard lock(_mutex);
+
+	_entries.insert_or_assign(data.id, Entry { stamp, data, true });
+	_dirty = true;
+}
+
+void Era2ModDataCache::save()
+{
+	std::lock_guard lock(_mutex);
+
+	std::erase_if(_entries, [&](const auto& item) {
+		if (item.second.requested)
+			return false;
+
+		_dirty = true;
+		return true;
+	});
+
+	for (auto& [id, entry] : _entries)
+		entry.requested = false;
+
+	if (!_dirty)
+		return;
+
+	BinaryWriter writer;
+	writer.buffer.append(Signature);
+	writer.write(FormatVersion);
+	writer.write(_context);
+	writer.write(static_cast<std::uint32_t>(_entries.size()));
+
+	for (const auto& [id, entry] : _entries)
+	{
+		writer.writeStamp(entry.stamp.info);
+		writer.writeStamp(entry.stamp.directory);
+		writeModData(writer, entry.data, _modIds);
+	}
+
+	overwriteFile(_path, writer.buffer);
+	_dirty = false;
+}
+
+void Era2ModDataCache::load()
+{
+	boost::nowide::ifstream file(_path, std::ios_base::in | std::ios_base::binary);
+	if (!file)
+		return;
+
+	std::stringstream content;
+	content << file.rdbuf();
+
+	const auto   buffer = content.str();
+	BinaryReader reader { buffer };
+
+	try
+	{
+		if (reader.take(Signature.size()) != Signature || reader.read<std::uint32_t>() != FormatVersion ||
+			reader.readString() != _context)
+			return;
+
+		for (auto size = reader.read<std::uint32_t>(); size > 0; --size)
+		{
+			Stamp stamp;
+			stamp.info      = reader.readStamp();
+			stamp.directory = reader.readStamp();
+
+			auto data = readModData(reader, _modIds);
+			auto id   = data.id;
+
+			_entries.insert_or_assign(std::move(id), Entry { stamp, std::move(data) });
+		}
+	}
+	catch (const corrupted_cache_error&)
+	{
+		_entries.clear();
+	}
+}
@@ -0,0 +1,61 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "domain/mod_data.hpp"
+#include "type/filesystem.hpp"
+#include "utility/fs_util.h"
+
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace mm
+{
+	// Keeps parsed mod.json between program runs.
+	// Entry is valid while mod.json has same size and modification time as when it was parsed,
+	// and mod directory has same modification time (data of mods without mod.json depends on it only)
+	struct Era2ModDataCache
+	{
+		struct Stamp
+		{
+			FileStamp info;       // mod.json
+			FileStamp directory;  // directory of mod itself
+
+			bool operator==(const Stamp&) const = default;
+		};
+
+		// context describes everything else loaded data depends on (language, defaults, ...)
+		// whole cache is discarded when it doesn't match
+		Era2ModDataCache(fs::path path, ModIdTable& modIds, std::string context);
+
+		std::optional<ModData> find(const std::string& id, const fs::path& loadFrom, const Stamp& stamp);
+		void                   store(const ModData& data, const Stamp& stamp);
+
+		// writes entries requested since previous save, rest are dropped
+		void save();
+
+	private:
+		void load();
+
+	private:
+		struct Entry
+		{
+			Stamp   stamp;
+			ModData data;
+			bool    requested = false;
+		};
+
+		const fs::path    _path;
+		ModIdTable&       _modIds;
+		const std::string _context;
+
+		std::mutex                             _mutex;
+		std::unordered_map<std::string, Entry> _entries;
+		bool                                   _dirty = false;
+	};
+}
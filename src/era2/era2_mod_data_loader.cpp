@@ -73,23 +73,25 @@ namespace
 			*section, defaultLng, i18Service.legacyCode(defaultLng), legacyUsed);
 	}
 
-	std::set<std::string> get_folded_string_set_from_json(const nlohmann::json& data)
+	std::set<ModId> get_mod_id_set_from_json(const nlohmann::json& data, ModIdTable& modIds)
 	{
-		std::set<std::string> result;
+		std::set<ModId> result;
 
 		for (const auto& item : data)
 			if (item.is_string())
-				result.emplace(boost::locale::fold_case(item.get<std::string>()));
+				result.emplace(modIds.intern(boost::locale::fold_case(item.get<std::string>())));
 
 		return result;
 	}
 }
 
 ModData Era2ModDataLoader::load(const std::string& id, const fs::path& loadFrom,
-	const std::string& preferredLng, const std::set<std::string>& defaultIncompatible,
-	const std::set<std::string>& defaultRequires, const std::set<std::string>& defaultLoadAfter,
+	const std::string& preferredLng, const std::set<ModId>& defaultIncompatible,
+	const std::set<ModId>& defaultRequires, const std::set<ModId>& defaultLoadAfter, ModIdTable& modIds,
 	const II18nService& i18Service)
 {
+	const auto wog = modIds.intern("wog");
+
 	bool hasRequires     = false;
 	bool hasLoadAfter    = false;
 	bool hasIncompatible = false;
@@ -108,7 +110,7 @@ ModData Era2ModDataLoader::load(const std::string& id, const fs::path& loadFrom,
 		{
 			result.requires_ = defaultRequires;
 			if (result.id != "wog")
-				result.requires_.emplace("wog");
+				result.requires_.emplace(wog);
 		}
 
 		if (!hasLoadAfter)
@@ -116,7 +118,7 @@ ModData Era2ModDataLoader::load(const std::string& id, const fs::path& loadFrom,
 			result.load_after = result.requires_;
 			result.load_after.insert(defaultLoadAfter.cbegin(), defaultLoadAfter.cend());
 			if (result.id != "wog")
-				result.load_after.emplace("wog");
+				result.load_after.emplace(wog);
 		}
 
 		if (!hasIncompatible)
@@ -213,7 +215,7 @@ ModData Era2ModDataLoader::load(const std::string& id, const fs::path& loadFrom,
 	{
 		if (const auto req = compat->find("requires"); req != compat->end() && req->is_array())
 		{
-			result.requires_  = get_folded_string_set_from_json(*req);
+			result.requires_  = get_mod_id_set_from_json(*req, modIds);
 			result.load_after = result.requires_;
 			hasRequires       = true;
 			hasLoadAfter      = true;
@@ -221,13 +223,13 @@ ModData Era2ModDataLoader::load(const std::string& id, const fs::path& loadFrom,
 
 		if (const auto after = compat->find("load_after"); after != compat->end() && after->is_array())
 		{
-			result.load_after.merge(get_folded_string_set_from_json(*after));
+			result.load_after.merge(get_mod_id_set_from_json(*after, modIds));
 			hasLoadAfter = true;
 		}
 
 		if (const auto inc = compat->find("incompatible"); inc != compat->end() && inc->is_array())
 		{
-			result.incompatible = get_folded_string_set_from_json(*inc);
+			result.incompatible = get_mod_id_set_from_json(*inc, modIds);
 			hasIncompatible     = true;
 		}
 	}
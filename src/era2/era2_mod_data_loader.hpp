@@ -18,6 +18,6 @@ namespace mm
 namespace mm::Era2ModDataLoader
 {
 	ModData load(const std::string& id, const fs::path& loadFrom, const std::string& preferredLng,
-		const std::set<std::string>& defaultIncompatible, const std::set<std::string>& defaultRequires,
-		const std::set<std::string>& defaultLoadAfter, const II18nService& i18Service);
+		const std::set<ModId>& defaultIncompatible, const std::set<ModId>& defaultRequires,
+		const std::set<ModId>& defaultLoadAfter, ModIdTable& modIds, const II18nService& i18Service);
 }
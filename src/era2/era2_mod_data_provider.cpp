@@ -7,7 +7,9 @@
 
 #include "era2_mod_data_provider.hpp"
 
+#include "era2_mod_data_cache.hpp"
 #include "era2_mod_data_loader.hpp"
+#include "interface/itask_scheduler.hpp"
 #include "system_info.hpp"
 #include "utility/fs_util.h"
 #include "utility/sdlexcept.h"
@@ -16,37 +18,60 @@
 
 using namespace mm;
 
+namespace
+{
+	const std::set<ModId>& findDefaults(const std::unordered_map<ModId, std::set<ModId>>& from, ModId id)
+	{
+		static const std::set<ModId> empty;
+
+		if (auto it = from.find(id); it != from.cend())
+			return it->second;
+
+		return empty;
+	}
+}
+
 Era2ModDataProvider::Era2ModDataProvider(fs::path basePath,
 	std::unordered_map<std::string, std::string> fsNameMapping, std::string preferredLng,
-	const II18nService& i18Service)
+	const II18nService& i18Service, ITaskScheduler& scheduler, const fs::path& cacheFile,
+	std::shared_ptr<ModIdTable> modIds)
 	: _basePath(std::move(basePath))
 	, _fsNameMapping(std::move(fsNameMapping))
 	, _preferredLng(std::move(preferredLng))
 	, _i18Service(i18Service)
+	, _scheduler(scheduler)
+	, _modIds(std::move(modIds))
 {
 	loadDefaults();
+
+	const auto defaultsStamp = fileStamp(defaultsPath());
+	_cache = std::make_unique<Era2ModDataCache>(cacheFile, *_modIds,
+		_preferredLng + '\n' + std::to_string(defaultsStamp.size) + ':' + std::to_string(defaultsStamp.time));
 }
 
+Era2ModDataProvider::~Era2ModDataProvider() = default;
+
 const ModData& Era2ModDataProvider::modData(const std::string& id)
 {
-	auto it = _data.find(id);
+	return modData(_modIds->intern(id));
+}
 
-	std::string dirName = id;
-	if (auto fsIt = _fsNameMapping.find(id); fsIt != _fsNameMapping.cend())
-		dirName = fsIt->second;
+const ModData& Era2ModDataProvider::modData(ModId id)
+{
+	auto it = _data.find(id);
 
 	if (it == _data.cend())
-	{
-		auto modData = mm::Era2ModDataLoader::load(id, _basePath / dirName, _preferredLng, _defaultIncompatible[id],
-			_defaultRequires[id], _defaultLoadAfter[id], _i18Service);
-
-		std::tie(it, std::ignore) = _data.emplace(id, std::move(modData));
-	}
+		std::tie(it, std::ignore) = _data.emplace(id, load(id));
 
 	return it->second;
 }
 
 const std::string& mm::Era2ModDataProvider::description(const std::string& id)
+{
+	return description(_modIds->intern(id));
+}
+
+const std::string& Era2ModDataProvider::description(ModId id)
 {
 	auto it = _description.find(id);
 
@@ -60,35 +85,118 @@ const std::string& mm::Era2ModDataProvider::description(const std::string& id)
 	return it->second;
 }
 
+size_t Era2ModDataProvider::generation() const
+{
+	return _generation;
+}
+
+const std::shared_ptr<ModIdTable>& Era2ModDataProvider::modIds() const
+{
+	return _modIds;
+}
+
+void Era2ModDataProvider::prefetch(const std::vector<ModId>& ids)
+{
+	std::vector<ModId> missing;
+	for (const auto& id : ids)
+		if (!_data.contains(id))
+			missing.emplace_back(id);
+
+	if (missing.empty())
+		return;
+
+	// loader doesn't touch provider state, so mods are loaded independently
+	std::vector<ModData> loaded(missing.size());
+	_scheduler.forEach(
+		TaskPriority::interactive, missing.size(), [&](size_t i) { loaded[i] = load(missing[i]); });
+
+	for (size_t i = 0; i < missing.size(); ++i)
+		_data.emplace(missing[i], std::move(loaded[i]));
+
+	_cache->save();
+}
+
+void Era2ModDataProvider::invalidate(const std::set<std::string>& ids)
+{
+	for (const auto& id : ids)
+	{
+		if (auto modId = _modIds->find(id))
+		{
+			_data.erase(*modId);
+			_description.erase(*modId);
+		}
+	}
+
+	++_generation;
+}
+
 void Era2ModDataProvider::clear()
 {
 	_data.clear();
 	_description.clear();
+
+	++_generation;
+}
+
+void Era2ModDataProvider::setFsNameMapping(std::unordered_map<std::string, std::string> fsNameMapping)
+{
+	_fsNameMapping = std::move(fsNameMapping);
+
+	++_generation;
+}
+
+ModData Era2ModDataProvider::load(ModId modId) const
+{
+	const auto& id = _modIds->string(modId);
+
+	std::string dirName = id;
+	if (auto it = _fsNameMapping.find(id); it != _fsNameMapping.cend())
+		dirName = it->second;
+
+	const auto loadFrom = _basePath / dirName;
+	const auto stamp    = Era2ModDataCache::Stamp {
+		fileStamp(loadFrom / mm::SystemInfo::ModInfoFilename), directoryStamp(loadFrom) };
+
+	if (auto cached = _cache->find(id, loadFrom, stamp))
+		return std::move(*cached);
+
+	auto result = mm::Era2ModDataLoader::load(id, loadFrom, _preferredLng,
+		findDefaults(_defaultIncompatible, modId), findDefaults(_defaultRequires, modId),
+		findDefaults(_defaultLoadAfter, modId), *_modIds, _i18Service);
+
+	_cache->store(result, stamp);
+
+	return result;
+}
+
+fs::path Era2ModDataProvider::defaultsPath()
+{
+	return fs::path(mm::SystemInfo::DataDir) / "era2.json";
 }
 
 void Era2ModDataProvider::loadDefaults()
 {
-	boost::nowide::ifstream datafile(fs::path(mm::SystemInfo::DataDir) / "era2.json");
+	boost::nowide::ifstream datafile(defaultsPath());
 
 	auto data = nlohmann::json::parse(datafile);
 	MM_EXPECTS(data.is_object(), unexpected_error);
 
 	for (const auto& [modId, modData] : data.items())
 	{
-		auto id = boost::locale::fold_case(modId);
+		auto id = _modIds->intern(boost::locale::fold_case(modId));
 
 		for (const auto& item : modData["incompatible"])
 		{
-			auto value = boost::locale::fold_case(item.get<std::string>());
+			auto value = _modIds->intern(boost::locale::fold_case(item.get<std::string>()));
 
 			_defaultIncompatible[id].emplace(value);
 			_defaultIncompatible[value].emplace(id);
 		}
 
 		for (const auto& item : modData["requires"])
-			_defaultRequires[id].emplace(boost::locale::fold_case(item.get<std::string>()));
+			_defaultRequires[id].emplace(_modIds->intern(boost::locale::fold_case(item.get<std::string>())));
 
 		for (const auto& item : modData["load_after"])
-			_defaultLoadAfter[id].emplace(boost::locale::fold_case(item.get<std::string>()));
+			_defaultLoadAfter[id].emplace(_modIds->intern(boost::locale::fold_case(item.get<std::string>())));
 	}
 }
@@ -9,38 +9,63 @@
 
 #include "type/filesystem.hpp"
 
-#include <map>
+#include <memory>
 #include <set>
+#include <vector>
 
 namespace mm
 {
 	struct Application;
 	struct II18nService;
+	struct ITaskScheduler;
+	struct Era2ModDataCache;
 
 	struct Era2ModDataProvider : IModDataProvider
 	{
 		Era2ModDataProvider(fs::path basePath, std::unordered_map<std::string, std::string> fsNameMapping,
-			std::string preferredLng, const II18nService& i18Service);
+			std::string preferredLng, const II18nService& i18Service, ITaskScheduler& scheduler,
+			const fs::path& cacheFile, std::shared_ptr<ModIdTable> modIds);
+		~Era2ModDataProvider() override;
 
 		const ModData&     modData(const std::string& id) override;
+		const ModData&     modData(ModId id) override;
 		const std::string& description(const std::string& id) override;
+		const std::string& description(ModId id) override;
+		size_t             generation() const override;
 
+		const std::shared_ptr<ModIdTable>& modIds() const override;
+
+		void prefetch(const std::vector<ModId>& ids);
+		void invalidate(const std::set<std::string>& ids);
 		void clear();
 
+		void setFsNameMapping(std::unordered_map<std::string, std::string> fsNameMapping);
+
 	private:
+		static fs::path defaultsPath();
+
 		void loadDefaults();
 
+		ModData load(ModId id) const;
+
 	private:
-		const fs::path                                     _basePath;
-		const std::string                                  _preferredLng;
-		const II18nService&                                _i18Service;
-		const std::unordered_map<std::string, std::string> _fsNameMapping;
+		const fs::path                               _basePath;
+		const std::string                            _preferredLng;
+		const II18nService&                          _i18Service;
+		ITaskScheduler&                              _scheduler;
+		std::unordered_map<std::string, std::string> _fsNameMapping;
+
+		const std::shared_ptr<ModIdTable> _modIds;
+
+		std::unordered_map<ModId, ModData>     _data;
+		std::unordered_map<ModId, std::string> _description;
+
+		std::unordered_map<ModId, std::set<ModId>> _defaultIncompatible;
+		std::unordered_map<ModId, std::set<ModId>> _defaultRequires;
+		std::unordered_map<ModId, std::set<ModId>> _defaultLoadAfter;
 
-		std::map<std::string, ModData>     _data;
-		std::map<std::string, std::string> _description;
+		std::unique_ptr<Era2ModDataCache> _cache;
 
-		std::map<std::string, std::set<std::string>> _defaultIncompatible;
-		std::map<std::string, std::set<std::string>> _defaultRequires;
-		std::map<std::string, std::set<std::string>> _defaultLoadAfter;
+		size_t _generation = 0;
 	};
 }
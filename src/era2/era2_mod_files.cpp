@@ -0,0 +1,592 @@
+// SD Mod Manager
+
+// Copyright (c) 2020-2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#include "stdafx.h"
+
+#include "era2_mod_files.hpp"
+
+#include "application.h"
+#include "domain/mod_data.hpp"
+#include "era2_archive_reader.hpp"
+#include "era2_content_hash_cache.hpp"
+#include "era2_file_manifest_cache.hpp"
+#include "era2_vfs_index.hpp"
+#include "interface/imod_data_provider.hpp"
+#include "interface/itask_scheduler.hpp"
+#include "utility/directory_walker.hpp"
+#include "utility/mapped_file.hpp"
+#include "utility/progress_channel.hpp"
+
+#include <boost/locale.hpp>
+#include <hash-library/md5.h>
+#include <wx/log.h>
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <optional>
+
+using namespace mm;
+
+namespace
+{
+	struct ScanContext
+	{
+		std::stop_token  token;
+		ITaskScheduler&  scheduler;
+		ProgressChannel& progress;
+	};
+
+	using PendingArchives = std::vector<std::pair<Era2FileManifest::Archive*, fs::path>>;
+
+	// returns false if some of archives can't be read, so manifest mustn't be cached
+	bool readArchives(ScanContext& context, const PendingArchives& pending)
+	{
+		std::atomic_bool complete = true;
+
+		context.scheduler.forEach(TaskPriority::interactive, pending.size(), [&](size_t i) {
+			if (context.token.stop_requested())
+				return;
+
+			const auto& [archive, path] = pending[i];
+
+			if (auto entries = Era2ArchiveReader::read(path))
+				archive->entries = std::move(*entries);
+			else
+				complete = false;
+		});
+
+		return complete;
+	}
+
+	bool upToDate(const Era2FileManifest& manifest, const fs::path& root)
+	{
+		auto sameStamp = [&](const auto& item) { return directoryStamp(root / item.first) == item.second; };
+
+		return !manifest.directories.empty() && std::ranges::all_of(manifest.directories, sameStamp);
+	}
+
+	struct ScanResult
+	{
+		bool complete = false;  // manifest can be cached
+		bool changed  = true;   // manifest isn't same as previous one
+	};
+
+	// Fills manifest of single directory, archives are read in parallel after directory is walked.
+	// Directory isn't walked again when nothing was added or removed since previous scan,
+	// archives are read again only if they were changed
+	ScanResult scanTree(ScanContext& context, Era2FileManifest& manifest,
+		std::optional<Era2FileManifest> previous, const fs::path& root, bool skipModsDir)
+	{
+		context.progress.setItem(root.string());
+
+		PendingArchives pending;
+
+		if (previous && upToDate(*previous, root))
+		{
+			manifest = std::move(*previous);
+
+			for (const auto& file : manifest.files)
+			{
+				if (file.archive == size_t(-1))
+					continue;
+
+				auto&      archive = manifest.archives[file.archive];
+				const auto stamp   = fileStamp(root / file.relative);
+
+				if (stamp != archive.stamp)
+				{
+					archive.stamp = stamp;
+					pending.emplace_back(&archive, root / file.relative);
+				}
+			}
+
+			return { readArchives(context, pending), !pending.empty() };
+		}
+
+		// [relative path] -> archive
+		std::unordered_map<std::string, const Era2FileManifest::Archive*> known;
+		if (previous)
+			for (const auto& file : previous->files)
+				if (file.archive != size_t(-1))
+					known.emplace(file.relative.string(), &previous->archives[file.archive]);
+
+		manifest.directories.emplace_back(fs::path(), directoryStamp(root));
+
+		if (!manifest.directories.front().second.exists)
+			return { true, true };
+
+		for (DirectoryWalker walker(root); walker.next();)
+		{
+			if (context.token.stop_requested())
+				return {};
+
+			const auto& entry = walker.entry();
+
+			if (skipModsDir && entry.path().filename() == "Mods")
+			{
+				walker.skipDirectory();
+				continue;
+			}
+
+			boost::system::error_code ec;
+
+			if (entry.is_directory(ec))
+			{
+				context.progress.setItem(entry.path().string());
+				manifest.directories.emplace_back(walker.relativePath(), directoryStamp(entry.path()));
+				continue;
+			}
+
+			const bool isFile = entry.is_regular_file(ec);
+			if (ec)
+				wxLogError(wxString("Can't access '%s'\r\n\r\n%s (code: %d)"_lng), entry.path().wstring(),
+					wxString::FromUTF8(ec.message()), ec.value());
+
+			if (!isFile)
+				continue;
+
+			auto& file    = manifest.files.emplace_back();
+			file.relative = walker.relativePath();
+
+			if (!Era2ArchiveReader::isArchiveExtension(walker.extension()))
+				continue;
+
+			file.archive  = manifest.archives.size();
+			auto& archive = manifest.archives.emplace_back();
+			archive.stamp = fileStamp(entry.path());
+
+			if (auto known_ = known.find(file.relative.string());
+				known_ != known.cend() && known_->second->stamp == archive.stamp)
+				archive.entries = known_->second->entries;
+			else
+				pending.emplace_back(&archive, entry.path());
+		}
+
+		return { readArchives(context, pending), true };
+	}
+
+	// drops mods without entries, remaining ones keep their order
+	void dropUnusedMods(Era2DirectoryStructure& data)
+	{
+		std::vector<size_t> entriesPerMod(data.mods.size());
+		for (const auto& entry : data.entries)
+			for (const auto& owner : entry.owners)
+				++entriesPerMod[owner.mod];
+
+		std::vector<std::uint32_t> remap(data.mods.size());
+		std::vector<std::string>   keptMods;
+
+		for (size_t i = 0; i < data.mods.size(); ++i)
+		{
+			remap[i] = static_cast<std::uint32_t>(keptMods.size());
+
+			if (entriesPerMod[i] > 0)
+				keptMods.emplace_back(std::move(data.mods[i]));
+		}
+
+		data.mods = std::move(keptMods);
+
+		for (auto& entry : data.entries)
+			for (auto& owner : entry.owners)
+				owner.mod = remap[owner.mod];
+	}
+}
+
+Era2DirectoryStructure mm::listModFiles(ITaskScheduler& scheduler, std::stop_token token,
+	const std::vector<std::string>& mods, Era2GameFiles gameFiles, bool includeNonOverriddenFiles,
+	bool includeFilesFromRootDir, IModDataProvider& dataProvider, const fs::path& basePath,
+	const fs::path& cachePath, ProgressChannel& progress, Era2VfsIndex* vfsIndex,
+	const BatchCallback& onBatch)
+{
+	progress.reset(mods.size());
+
+	std::optional<Era2FileManifestCache> cache;
+	if (!cachePath.empty())
+		cache.emplace(cachePath);
+
+	auto takeCached = [&](const fs::path& root) -> std::optional<Era2FileManifest> {
+		return cache ? cache->take(root) : std::nullopt;
+	};
+
+	std::vector<fs::path> modRoots;
+	std::vector<fs::path> modPaths;  // relative to base path
+	for (const auto& mod : mods)
+	{
+		boost::system::error_code ec;
+
+		modRoots.emplace_back(dataProvider.modData(mod).data_path);
+		modPaths.emplace_back(fs::relative(modRoots.back(), basePath, ec));
+	}
+
+	Era2DirectoryStructure result;
+	result.mods = mods;
+
+	std::unordered_map<std::string, std::uint32_t> pathIds;   // [path] -> index in paths
+	std::unordered_map<std::string, size_t>        entryIds;  // [folded virtual path] -> index in entries
+
+	auto pathId = [&](std::string path) {
+		const auto next     = static_cast<std::uint32_t>(result.paths.size());
+		auto [it, inserted] = pathIds.try_emplace(std::move(path), next);
+		if (inserted)
+			result.paths.emplace_back(it->first);
+
+		return it->second;
+	};
+
+	auto fileIndex = [&](const fs::path& path, bool createNew = true) {
+		auto value = path.string();
+
+		auto it = entryIds.find(boost::locale::fold_case(value));
+		if (it == entryIds.cend())
+		{
+			if (!createNew)
+				return size_t(-1);
+
+			result.entries.emplace_back().filePath = pathId(value);
+
+			std::tie(it, std::ignore) =
+				entryIds.emplace(boost::locale::fold_case(std::move(value)), result.entries.size() - 1);
+		}
+
+		return it->second;
+	};
+
+	auto visible = [&](const Era2FileEntry& entry) {
+		if (entry.owners.size() < (includeNonOverriddenFiles ? 1 : 2))
+			return false;
+
+		return includeFilesFromRootDir ||
+			   result.paths[entry.filePath].find_first_of("\\/") != std::string::npos;
+	};
+
+	// entries are reported as soon as they become visible, so rows are numbered in that order
+	constexpr auto      npos = size_t(-1);
+	std::vector<size_t> rows;  // [entry] -> row
+	size_t              rowCount      = 0;
+	size_t              reportedPaths = 0;
+	std::vector<size_t> touched;
+
+	auto mergeMod = [&](size_t i, Era2FileManifest& manifest) {
+		const auto  mod     = static_cast<std::uint32_t>(i);
+		const auto& modPath = modPaths[i];
+
+		auto addOwner = [&](size_t index, std::uint32_t path, bool archived) {
+			auto& owners = result.entries[index].owners;
+
+			if (owners.empty() || owners.back().mod != mod)
+			{
+				owners.emplace_back(Era2FileOwner { mod, path, archived });
+				touched.emplace_back(index);
+			}
+			else if (!archived)
+			{
+				owners.back() = Era2FileOwner { mod, path, archived };
+			}
+		};
+
+		for (const auto& file : manifest.files)
+		{
+			const auto path = pathId((modPath / file.relative).string());
+
+			// loose file has precedence over archive of same mod
+			addOwner(fileIndex(file.relative), path, false);
+
+			if (file.archive == size_t(-1))
+				continue;
+
+			for (const auto& entry : manifest.archives[file.archive].entries)
+				addOwner(fileIndex(file.relative.parent_path() / entry.name), path, true);
+		}
+	};
+
+	auto reportBatch = [&] {
+		Era2FileListBatch batch;
+		batch.paths.assign(result.paths.cbegin() + reportedPaths, result.paths.cend());
+		reportedPaths = result.paths.size();
+
+		rows.resize(result.entries.size(), npos);
+
+		for (const auto index : touched)
+		{
+			if (!visible(result.entries[index]))
+				continue;
+
+			if (rows[index] == npos)
+				rows[index] = rowCount++;
+
+			batch.rows.emplace_back(rows[index], result.entries[index]);
+		}
+
+		touched.clear();
+
+		if (!batch.rows.empty())
+			onBatch(std::move(batch));
+	};
+
+	// every directory is scanned by separate task, archives inside of it are read in parallel too.
+	// Mod is merged as soon as every mod before it is scanned, by whoever scanned the last of them;
+	// last root is game directory, it's merged after all mods
+	const size_t                  roots = mods.size() + (gameFiles != Era2GameFiles::none ? 1 : 0);
+	std::vector<Era2FileManifest> modManifests(mods.size());
+	Era2FileManifest              gameManifest;
+	std::vector<ScanResult>       scans(roots);
+
+	std::vector<std::optional<Era2FileManifest>> previous;
+	for (const auto& root : modRoots)
+		previous.emplace_back(takeCached(root));
+
+	if (gameFiles != Era2GameFiles::none)
+		previous.emplace_back(takeCached(basePath));
+
+	ScanContext       context { token, scheduler, progress };
+	std::mutex        mergeAccess;
+	std::vector<char> scanned(mods.size());  // guarded by mergeAccess
+	size_t            merged = 0;            // guarded by mergeAccess
+
+	scheduler.forEach(TaskPriority::interactive, roots, [&](size_t i) {
+		if (token.stop_requested())
+			return;
+
+		if (i == mods.size())
+		{
+			scans[i] = scanTree(context, gameManifest, std::move(previous[i]), basePath, true);
+			return;
+		}
+
+		scans[i] = scanTree(context, modManifests[i], std::move(previous[i]), modRoots[i], false);
+
+		std::lock_guard lock(mergeAccess);
+		scanned[i] = true;
+
+		for (; merged < mods.size() && scanned[merged]; ++merged)
+		{
+			mergeMod(merged, modManifests[merged]);
+			progress.advance();
+
+			if (onBatch)
+				reportBatch();
+		}
+	});
+
+	progress.setItem({});
+
+	if (token.stop_requested())
+		return {};
+
+	for (const auto& file : gameManifest.files)
+	{
+		const auto path = pathId(file.relative.string());
+
+		if (const auto index = fileIndex(file.relative, gameFiles == Era2GameFiles::all); index != size_t(-1))
+			result.entries[index].gamePath = path;
+
+		if (file.archive == size_t(-1))
+			continue;
+
+		for (const auto& entry : gameManifest.archives[file.archive].entries)
+		{
+			const auto lodIndex =
+				fileIndex(file.relative.parent_path() / entry.name, gameFiles == Era2GameFiles::all);
+			if (lodIndex == size_t(-1))
+				continue;
+
+			auto& subItem = result.entries[lodIndex];
+
+			if (!subItem.gamePath)
+				subItem.gamePath = path;
+		}
+	}
+
+	// index is updated only for directories, which content was changed (or which it doesn't know yet),
+	// rest of mods are just re-ranked by new order
+	if (vfsIndex)
+	{
+		for (size_t i = 0; i < mods.size(); ++i)
+			if (scans[i].changed || !vfsIndex->contains(mods[i]))
+				vfsIndex->setMod(mods[i], modPaths[i], modManifests[i]);
+
+		if (gameFiles == Era2GameFiles::none)
+			vfsIndex->removeMod({});  // game files of previous scan mustn't stay in reused index
+		else if (scans[mods.size()].changed || !vfsIndex->contains({}))
+			vfsIndex->setGame(gameManifest);
+
+		vfsIndex->setOrder(mods);
+	}
+
+	if (cache)
+	{
+		for (size_t i = 0; i < mods.size(); ++i)
+			if (scans[i].complete)
+				cache->store(modRoots[i], std::move(modManifests[i]));
+
+		if (gameFiles != Era2GameFiles::none && scans[mods.size()].complete)
+			cache->store(basePath, std::move(gameManifest));
+
+		cache->save();
+	}
+
+	std::erase_if(result.entries, [&](const Era2FileEntry& entry) { return !visible(entry); });
+
+	dropUnusedMods(result);
+
+	return result;
+}
+
+void mm::collapseIdenticalFiles(ITaskScheduler& scheduler, std::stop_token token,
+	Era2DirectoryStructure& data, bool includeNonOverriddenFiles, const fs::path& basePath,
+	const fs::path& cachePath, ProgressChannel& progress)
+{
+	std::optional<Era2ContentHashCache> cache;
+	if (!cachePath.empty())
+		cache.emplace(cachePath);
+
+	using Requests = std::vector<std::pair<size_t, size_t>>;  // (entry, owner)
+
+	// every physical file is hashed by single task, archive is mapped once for all its entries
+	std::unordered_map<std::uint32_t, Requests>          requests;                     // [path] -> requests
+	std::vector<std::vector<std::optional<ContentHash>>> hashes(data.entries.size());  // [entry][owner]
+
+	for (size_t i = 0; i < data.entries.size(); ++i)
+	{
+		const auto& owners = data.entries[i].owners;
+		if (owners.size() < 2)
+			continue;
+
+		hashes[i].resize(owners.size());
+		for (size_t j = 0; j < owners.size(); ++j)
+			requests[owners[j].path].emplace_back(i, j);
+	}
+
+	auto hashOf = [](std::string_view bytes) {
+		MD5 md5;
+		md5.add(bytes.data(), bytes.size());
+
+		ContentHash result;
+		md5.getHash(result.data());
+
+		return result;
+	};
+
+	progress.reset(requests.size());
+
+	auto hashFile = [&](std::uint32_t pathIndex, const Requests& items) {
+		const auto path = basePath / data.paths[pathIndex];
+
+		progress.setItem(path.string());
+
+		Era2ContentHashCache::File cached;
+		if (cache)
+			cached = cache->take(path, fileStamp(path));
+
+		std::optional<MappedFile>                                        mapped;
+		std::optional<std::unordered_map<std::string, Era2ArchiveEntry>> archive;  // [folded name] -> entry
+
+		auto content = [&]() -> std::string_view {
+			if (!mapped)
+				mapped.emplace(path);
+
+			return mapped->data();
+		};
+
+		auto archiveEntry = [&](size_t entry) -> const Era2ArchiveEntry* {
+			if (!archive)
+			{
+				archive.emplace();
+				for (auto& item : Era2ArchiveReader::read(path).value_or(std::vector<Era2ArchiveEntry>()))
+					archive->try_emplace(boost::locale::fold_case(item.name), std::move(item));
+			}
+
+			const auto name = fs::path(data.paths[data.entries[entry].filePath]).filename().string();
+			const auto it   = archive->find(boost::locale::fold_case(name));
+
+			return it != archive->cend() ? &it->second : nullptr;
+		};
+
+		for (const auto& [entry, owner] : items)
+		{
+			if (token.stop_requested())
+				return;
+
+			std::uint32_t offset = Era2ContentHashCache::WholeFile;
+			size_t        size   = std::string_view::npos;
+
+			if (data.entries[entry].owners[owner].archived)
+			{
+				const auto item = archiveEntry(entry);
+				if (!item)
+					continue;
+
+				offset = item->offset;
+				size   = item->storedSize();
+			}
+
+			if (auto it = cached.hashes.find(offset); it != cached.hashes.cend())
+			{
+				hashes[entry][owner] = it->second;
+				continue;
+			}
+
+			const auto wholeFile = offset == Era2ContentHashCache::WholeFile;
+			const auto bytes     = content();
+
+			if (!mapped->valid() || (!wholeFile && offset + size > bytes.size()))
+				continue;
+
+			const auto hash = hashOf(wholeFile ? bytes : bytes.substr(offset, size));
+
+			hashes[entry][owner] = hash;
+			cached.hashes.emplace(offset, hash);
+		}
+
+		if (cache)
+			cache->store(path, std::move(cached));
+
+		progress.advance();
+	};
+
+	std::vector<const decltype(requests)::value_type*> files;
+	for (const auto& item : requests)
+		files.emplace_back(&item);
+
+	scheduler.forEach(TaskPriority::interactive, files.size(),
+		[&](size_t i) { hashFile(files[i]->first, files[i]->second); });
+
+	progress.setItem({});
+
+	if (token.stop_requested())
+		return;
+
+	if (cache)
+		cache->save();
+
+	// owner with same content as owner before it isn't a real override
+	for (size_t i = 0; i < data.entries.size(); ++i)
+	{
+		auto&       owners = data.entries[i].owners;
+		const auto& known  = hashes[i];
+
+		if (known.empty())
+			continue;
+
+		std::vector<Era2FileOwner> kept;
+		for (size_t j = 0; j < owners.size(); ++j)
+		{
+			const auto sameAsPrevious = known[j] && std::any_of(known.cbegin(), known.cbegin() + j,
+														 [&](const auto& item) { return item == known[j]; });
+
+			if (!sameAsPrevious)
+				kept.emplace_back(owners[j]);
+		}
+
+		owners = std::move(kept);
+	}
+
+	std::erase_if(data.entries, [&](const Era2FileEntry& entry) {
+		return entry.owners.size() < (includeNonOverriddenFiles ? 1 : 2);
+	});
+
+	dropUnusedMods(data);
+}
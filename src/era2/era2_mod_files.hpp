@@ -0,0 +1,61 @@
+// SD Mod Manager
+
+// Copyright (c) 2020-2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "era2_directory_structure.hpp"
+#include "type/filesystem.hpp"
+
+#include <functional>
+#include <stop_token>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mm
+{
+	struct IModDataProvider;
+	struct ITaskScheduler;
+	struct ProgressChannel;
+	class Era2VfsIndex;
+
+	enum class Era2GameFiles
+	{
+		none,
+		overriden_only,
+		all
+	};
+
+	// Part of result, reported while rest of mods are still being scanned.
+	// Owners refer to `mods` as passed to listModFiles, unused mods aren't dropped yet
+	struct Era2FileListBatch
+	{
+		std::vector<std::string>                      paths;  // appended to previously reported ones
+		std::vector<std::pair<size_t, Era2FileEntry>> rows;   // [row] -> entry, new rows come in order
+	};
+
+	using BatchCallback = std::function<void(Era2FileListBatch)>;
+
+	// Collects files of mods (including content of archives) into single virtual tree, directories are
+	// scanned on workers of `scheduler`.
+	// Listings of directories are kept in `cachePath` (if it isn't empty) and reused while they're valid.
+	// Progress is counted in merged mods, empty result is returned if stop is requested.
+	// If `onBatch` is set, it's called (from worker, one call at a time) after each mod is merged
+	// in load order, batches contain only mod files, game files are only in final result.
+	// If `vfsIndex` is set, scanned mods (and game files) are put into it with `mods` as load order
+	Era2DirectoryStructure listModFiles(ITaskScheduler& scheduler, std::stop_token token,
+		const std::vector<std::string>& mods, Era2GameFiles gameFiles, bool includeNonOverriddenFiles,
+		bool includeFilesFromRootDir, IModDataProvider& dataProvider, const fs::path& basePath,
+		const fs::path& cachePath, ProgressChannel& progress, Era2VfsIndex* vfsIndex = nullptr,
+		const BatchCallback& onBatch = {});
+
+	// Hashes content of overridden files (on workers of `scheduler`) and drops owners, which provide
+	// same content as owner before them, entries without real overrides are dropped then.
+	// Progress is counted in files.
+	// Hashes are kept in `cachePath` (if it isn't empty), so unchanged files aren't read again
+	void collapseIdenticalFiles(ITaskScheduler& scheduler, std::stop_token token,
+		Era2DirectoryStructure& data, bool includeNonOverriddenFiles, const fs::path& basePath,
+		const fs::path& cachePath, ProgressChannel& progress);
+}
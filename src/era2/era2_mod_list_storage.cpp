@@ -0,0 +1,116 @@
+// SD Mod Manager
+
+// Copyright (c) 2020-2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#include "stdafx.h"
+
+#include "era2_mod_list_storage.hpp"
+
+#include "utility/fs_util.h"
+
+#include <boost/locale/conversion.hpp>
+#include <boost/range/adaptor/reversed.hpp>
+
+using namespace mm;
+
+namespace
+{
+	bool validateModId(std::string& id, ModList::ModState& state)
+	{
+		boost::trim(id);
+		if (id.empty())
+			return false;
+
+		state = ModList::ModState::enabled;
+		if (id.starts_with('*'))
+		{
+			id    = id.substr(1);
+			state = ModList::ModState::disabled;
+		}
+
+		return true;
+	}
+}
+
+std::unordered_map<std::string, std::string> Era2ModListStorage::loadFsMapNames(const fs::path& modsPath)
+{
+	std::unordered_map<std::string, std::string> result;
+
+	if (exists(modsPath))
+	{
+		using di = fs::directory_iterator;
+		for (auto it = di(modsPath), end = di(); it != end; ++it)
+		{
+			if (!it->is_directory())
+				continue;
+
+			const auto item = it->path().filename().string();
+
+			result[boost::locale::fold_case(item)] = item;
+		}
+	}
+
+	return result;
+}
+
+ModList Era2ModListStorage::load(
+	const fs::path& activePath, const fs::path& modsPath, std::shared_ptr<ModIdTable> modIds)
+{
+	ModList           items(std::move(modIds));
+	ModList::ModState state = ModList::ModState::enabled;
+
+	// active mods / ignore mm_managed_mod
+	std::vector<std::string> activeMods;
+	boost::split(activeMods, readFile(activePath), boost::is_any_of("\r\n"));
+
+	for (auto& item : boost::adaptors::reverse(activeMods))
+	{
+		auto id = boost::locale::fold_case(item);
+
+		if (validateModId(id, state) && !items.managed(id))
+			items.add(items.ids->intern(id), state);
+	}
+
+	// remaining items from directory
+	if (exists(modsPath))
+	{
+		using di = fs::directory_iterator;
+		for (auto it = di(modsPath), end = di(); it != end; ++it)
+		{
+			if (!it->is_directory())
+				continue;
+
+			const auto item = it->path().filename().string();
+			const auto id   = boost::locale::fold_case(item);
+
+			if (!items.managed(id))
+				items.addArchived(items.ids->intern(id));
+		}
+	}
+
+	return items;
+}
+
+void Era2ModListStorage::save(const fs::path& activePath, const fs::path& modsPath, const ModList& mods)
+{
+	auto map = loadFsMapNames(modsPath);
+
+	std::vector<std::string> toSave;
+
+	for (const auto& item : boost::adaptors::reverse(mods.data()))
+	{
+		const auto& id    = mods.string(item.id);
+		auto        value = map[id];
+		if (value.empty())
+			value = id;
+
+		switch (item.state)
+		{
+		case ModList::ModState::enabled: toSave.emplace_back(value); break;
+		case ModList::ModState::disabled: toSave.emplace_back('*' + value); break;
+		}
+	}
+
+	overwriteFileFromContainer(activePath, toSave);
+}
@@ -0,0 +1,23 @@
+// SD Mod Manager
+
+// Copyright (c) 2020-2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "domain/mod_list.hpp"
+#include "type/filesystem.hpp"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace mm::Era2ModListStorage
+{
+	// folded directory name -> actual directory name
+	std::unordered_map<std::string, std::string> loadFsMapNames(const fs::path& modsPath);
+
+	// reads list.txt, directories which are not mentioned there are added as archived
+	ModList load(const fs::path& activePath, const fs::path& modsPath, std::shared_ptr<ModIdTable> modIds);
+	void    save(const fs::path& activePath, const fs::path& modsPath, const ModList& mods);
+}
@@ -9,129 +9,49 @@
 #include "application.h"
 #include "era2_config.hpp"
 #include "era2_launch_helper.hpp"
+#include "era2_mod_change_tracker.hpp"
 #include "era2_mod_data_provider.hpp"
+#include "era2_mod_list_storage.hpp"
 #include "era2_mod_manager.hpp"
 #include "era2_preset_manager.hpp"
 #include "interface/iapp_config.hpp"
 #include "utility/fs_util.h"
 
-#include <fstream>
-
-#include <boost/locale/conversion.hpp>
-#include <boost/range/adaptor/reversed.hpp>
-
 using namespace mm;
 
 namespace
 {
-	std::unordered_map<std::string, std::string> loadFsMapNames(const fs::path& modsPath)
+	std::vector<ModId> allModIds(const ModList& list)
 	{
-		std::unordered_map<std::string, std::string> result;
-
-		if (exists(modsPath))
-		{
-			using di = fs::directory_iterator;
-			for (auto it = di(modsPath), end = di(); it != end; ++it)
-			{
-				if (!it->is_directory())
-					continue;
+		std::vector<ModId> result;
+		result.reserve(list.data().size() + list.rest().size());
 
-				const auto item = it->path().filename().string();
+		for (const auto& item : list.data())
+			result.emplace_back(item.id);
 
-				result[boost::locale::fold_case(item)] = item;
-			}
-		}
+		result.insert(result.end(), list.rest().cbegin(), list.rest().cend());
 
 		return result;
 	}
-
-	bool validateModId(std::string& id, ModList::ModState& state)
-	{
-		boost::trim(id);
-		if (id.empty())
-			return false;
-
-		state = ModList::ModState::enabled;
-		if (id.starts_with('*'))
-		{
-			id    = id.substr(1);
-			state = ModList::ModState::disabled;
-		}
-
-		return true;
-	}
-
-	ModList loadMods(const fs::path& activePath, const fs::path& modsPath)
-	{
-		ModList           items;
-		ModList::ModState state = ModList::ModState::enabled;
-
-		// active mods / ignore mm_managed_mod
-		std::vector<std::string> activeMods;
-		boost::split(activeMods, readFile(activePath), boost::is_any_of("\r\n"));
-
-		for (auto& item : boost::adaptors::reverse(activeMods))
-		{
-			auto id = boost::locale::fold_case(item);
-
-			if (validateModId(id, state) && !items.managed(id))
-				items.data.emplace_back(id, state);
-		}
-
-		// remaining items from directory
-		if (exists(modsPath))
-		{
-			using di = fs::directory_iterator;
-			for (auto it = di(modsPath), end = di(); it != end; ++it)
-			{
-				if (!it->is_directory())
-					continue;
-
-				const auto item = it->path().filename().string();
-				const auto id   = boost::locale::fold_case(item);
-
-				if (!items.managed(id))
-					items.rest.emplace(id);
-			}
-		}
-
-		return items;
-	}
-
-	void saveMods(const fs::path& activePath, const fs::path& modsPath, const ModList& mods)
-	{
-		auto map = loadFsMapNames(modsPath);
-
-		std::vector<std::string> toSave;
-
-		for (const auto& item : boost::adaptors::reverse(mods.data))
-		{
-			auto value = map[item.id];
-			if (value.empty())
-				value = item.id;
-
-			switch (item.state)
-			{
-			case ModList::ModState::enabled: toSave.emplace_back(value); break;
-			case ModList::ModState::disabled: toSave.emplace_back('*' + value); break;
-			}
-		}
-
-		overwriteFileFromContainer(activePath, toSave);
-	}
 }
 
 Era2Platform::Era2Platform(const Application& app)
 	: _app(app)
 	, _rootDir(app.appConfig().getDataPath())
+	, _modIds(std::make_shared<ModIdTable>())
 {
 	_localConfig     = std::make_unique<Era2Config>(_rootDir);
 	_presetManager   = std::make_unique<Era2PresetManager>(_localConfig->getPresetsPath(), modsDirPath());
 	_launchHelper    = std::make_unique<Era2LaunchHelper>(*_localConfig);
 	_modDataProvider = std::make_unique<Era2ModDataProvider>(modsDirPath(),
-		loadFsMapNames(modsDirPath()), _app.appConfig().currentLanguageCode(), _app.i18nService());
+		Era2ModListStorage::loadFsMapNames(modsDirPath()), _app.appConfig().currentLanguageCode(),
+		_app.i18nService(), _app.taskScheduler(), _localConfig->getProgramDataPath() / "mod_data.cache",
+		_modIds);
+
+	_changeTracker = std::make_unique<Era2ModChangeTracker>(modsDirPath(), getActiveListPath());
 
-	_modList    = loadMods(getActiveListPath(), modsDirPath());
+	_modList = Era2ModListStorage::load(getActiveListPath(), modsDirPath(), _modIds);
+	_modDataProvider->prefetch(allModIds(_modList));
 	_modManager = std::make_unique<Era2ModManager>(_modList);
 
 	_modListChanged = _modManager->onListChanged().connect([this] { save(); });
@@ -144,11 +64,26 @@ fs::path Era2Platform::managedPath() const
 
 void Era2Platform::reload(bool force)
 {
-	auto mods = loadMods(getActiveListPath(), modsDirPath());
-	if (!force && mods == _modManager->mods())
+	const auto changes = _changeTracker->poll();
+	if (!force && changes.empty())
 		return;
 
-	_modDataProvider->clear();
+	if (force || changes.directoriesChanged)
+		_modDataProvider->setFsNameMapping(Era2ModListStorage::loadFsMapNames(modsDirPath()));
+
+	auto mods = _modManager->mods();
+	if (force || changes.listChanged || changes.directoriesChanged)
+		mods = Era2ModListStorage::load(getActiveListPath(), modsDirPath(), _modIds);
+
+	if (!force && changes.mods.empty() && mods == _modManager->mods())
+		return;
+
+	if (force)
+		_modDataProvider->clear();
+	else
+		_modDataProvider->invalidate(changes.mods);
+
+	_modDataProvider->prefetch(allModIds(mods));
 	auto block = _modListChanged.blocker();
 
 	_modManager->mods(mods);
@@ -207,5 +142,6 @@ fs::path Era2Platform::getPluginListPath() const
 
 void Era2Platform::save()
 {
-	saveMods(getActiveListPath(), modsDirPath(), _modManager->mods());
+	Era2ModListStorage::save(getActiveListPath(), modsDirPath(), _modManager->mods());
+	_changeTracker->listSaved();
 }
@@ -18,6 +18,7 @@ namespace mm
 {
 	struct Application;
 	struct Era2LaunchHelper;
+	struct Era2ModChangeTracker;
 	struct Era2ModManager;
 	struct Era2PresetManager;
 	struct Era2ModDataProvider;
@@ -46,14 +47,16 @@ namespace mm
 		void save();
 
 	private:
-		const Application& _app;
-		const fs::path     _rootDir;
-
-		std::unique_ptr<Era2Config>          _localConfig;
-		std::unique_ptr<Era2LaunchHelper>    _launchHelper;
-		std::unique_ptr<Era2ModDataProvider> _modDataProvider;
-		std::unique_ptr<Era2ModManager>      _modManager;
-		std::unique_ptr<Era2PresetManager>   _presetManager;
+		const Application&               _app;
+		const fs::path                    _rootDir;
+		const std::shared_ptr<ModIdTable> _modIds;
+
+		std::unique_ptr<Era2Config>           _localConfig;
+		std::unique_ptr<Era2LaunchHelper>     _launchHelper;
+		std::unique_ptr<Era2ModChangeTracker> _changeTracker;
+		std::unique_ptr<Era2ModDataProvider>  _modDataProvider;
+		std::unique_ptr<Era2ModManager>       _modManager;
+		std::unique_ptr<Era2PresetManager>    _presetManager;
 
 		ModList _modList;
 
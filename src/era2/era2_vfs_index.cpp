@@ -0,0 +1,294 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#include "stdafx.h"
+
+#include "era2_vfs_index.hpp"
+
+#include <boost/locale.hpp>
+
+using namespace mm;
+
+namespace
+{
+	constexpr auto Detached = size_t(-1);
+	constexpr auto GameRank = size_t(-2);  // game files lose to any mod
+
+	std::string normalize(std::string_view path)
+	{
+		std::string result(path);
+		std::ranges::replace(result, '\\', '/');
+
+		boost::trim_if(result, [](char c) { return c == '/'; });
+
+		return result;
+	}
+
+	std::string foldedKey(std::string_view path)
+	{
+		return boost::locale::fold_case(normalize(path));
+	}
+
+	// both are empty for root
+	std::string_view parentOf(std::string_view path)
+	{
+		const auto pos = path.rfind('/');
+
+		return pos == std::string_view::npos ? std::string_view() : path.substr(0, pos);
+	}
+
+	std::string_view nameOf(std::string_view path)
+	{
+		const auto pos = path.rfind('/');
+
+		return pos == std::string_view::npos ? path : path.substr(pos + 1);
+	}
+}
+
+void Era2VfsIndex::setMod(const std::string& mod, const fs::path& modPath, const Era2FileManifest& manifest)
+{
+	std::vector<LayerFile> files;
+
+	auto add = [&](const fs::path& virtualPath, const fs::path& physicalPath, bool archived) {
+		auto path = normalize(virtualPath.string());
+		auto key  = boost::locale::fold_case(path);
+
+		files.emplace_back(LayerFile {
+			std::move(key), std::move(path), Era2VfsSource { mod, physicalPath.string(), archived } });
+	};
+
+	for (const auto& file : manifest.files)
+	{
+		const auto physicalPath = modPath / file.relative;
+
+		add(file.relative, physicalPath, false);
+
+		if (file.archive == size_t(-1))
+			continue;
+
+		for (const auto& entry : manifest.archives[file.archive].entries)
+			add(file.relative.parent_path() / entry.name, physicalPath, true);
+	}
+
+	setLayer(mod, std::move(files));
+}
+
+void Era2VfsIndex::setGame(const Era2FileManifest& manifest)
+{
+	setMod({}, {}, manifest);
+}
+
+void Era2VfsIndex::removeMod(const std::string& mod)
+{
+	auto it = _layers.find(mod);
+	if (it == _layers.end())
+		return;
+
+	detach(it->second);
+	_layers.erase(it);
+
+	sortTouched();
+}
+
+bool Era2VfsIndex::contains(const std::string& mod) const
+{
+	return _layers.contains(mod);
+}
+
+void Era2VfsIndex::setOrder(const std::vector<std::string>& enabled)
+{
+	_ranks.clear();
+	for (size_t i = 0; i < enabled.size(); ++i)
+		_ranks.try_emplace(enabled[i], i);
+
+	for (auto& [mod, layer] : _layers)
+	{
+		if (mod.empty())
+			continue;
+
+		const auto it   = _ranks.find(mod);
+		const auto rank = it != _ranks.cend() ? it->second : Detached;
+
+		if (rank == layer.rank)
+			continue;
+
+		if (layer.rank == Detached)
+			attach(layer, rank);
+		else if (rank == Detached)
+			detach(layer);
+		else
+			rerank(layer, rank);
+	}
+
+	sortTouched();
+}
+
+const Era2VfsSource* Era2VfsIndex::find(std::string_view path) const
+{
+	const auto it = _files.find(foldedKey(path));
+
+	return it != _files.cend() ? it->second.providers.front().source : nullptr;
+}
+
+std::vector<const Era2VfsSource*> Era2VfsIndex::sources(std::string_view path) const
+{
+	std::vector<const Era2VfsSource*> result;
+
+	if (const auto it = _files.find(foldedKey(path)); it != _files.cend())
+		for (const auto& provider : it->second.providers)
+			result.emplace_back(provider.source);
+
+	return result;
+}
+
+std::vector<Era2VfsIndex::Entry> Era2VfsIndex::list(std::string_view directory) const
+{
+	const auto it = _directories.find(foldedKey(directory));
+	if (it == _directories.cend())
+		return {};
+
+	std::vector<std::pair<std::string_view, Entry>> items;  // [folded path] -> entry
+
+	for (const auto& key : it->second.children)
+	{
+		if (const auto file = _files.find(key); file != _files.cend())
+		{
+			const auto& [path, providers] = file->second;
+			items.emplace_back(key, Entry { std::string(nameOf(path)), providers.front().source });
+		}
+		else if (const auto subdir = _directories.find(key); subdir != _directories.cend())
+			items.emplace_back(key, Entry { subdir->second.name, nullptr });
+	}
+
+	std::ranges::sort(items, {}, &std::pair<std::string_view, Entry>::first);
+
+	std::vector<Entry> result;
+	for (auto& item : items)
+		result.emplace_back(std::move(item.second));
+
+	return result;
+}
+
+size_t Era2VfsIndex::size() const
+{
+	return _files.size();
+}
+
+void Era2VfsIndex::setLayer(const std::string& mod, std::vector<LayerFile> files)
+{
+	auto& layer = _layers[mod];
+
+	detach(layer);
+	layer.files = std::move(files);
+
+	if (mod.empty())
+		attach(layer, GameRank);
+	else if (const auto it = _ranks.find(mod); it != _ranks.cend())
+		attach(layer, it->second);
+
+	sortTouched();
+}
+
+void Era2VfsIndex::attach(Layer& layer, size_t rank)
+{
+	layer.rank = rank;
+
+	for (const auto& file : layer.files)
+	{
+		auto [it, inserted] = _files.try_emplace(file.key);
+		if (inserted)
+		{
+			it->second.path = file.path;
+			addToDirectory(file.key, file.path);
+		}
+
+		it->second.providers.emplace_back(Provider { &layer, &file.source });
+		_touched.emplace(file.key);
+	}
+}
+
+void Era2VfsIndex::detach(Layer& layer)
+{
+	if (layer.rank == Detached)
+		return;
+
+	layer.rank = Detached;
+
+	for (const auto& file : layer.files)
+	{
+		const auto it = _files.find(file.key);
+		if (it == _files.end())
+			continue;
+
+		std::erase_if(it->second.providers, [&](const Provider& item) { return item.layer == &layer; });
+
+		if (!it->second.providers.empty())
+		{
+			_touched.emplace(file.key);
+			continue;
+		}
+
+		_touched.erase(file.key);
+		_files.erase(it);
+		removeFromDirectory(file.key);
+	}
+}
+
+void Era2VfsIndex::rerank(Layer& layer, size_t rank)
+{
+	layer.rank = rank;
+
+	for (const auto& file : layer.files)
+		_touched.emplace(file.key);
+}
+
+void Era2VfsIndex::sortTouched()
+{
+	for (const auto& key : _touched)
+	{
+		if (const auto it = _files.find(key); it != _files.end())
+		{
+			std::ranges::stable_sort(it->second.providers, {}, [](const Provider& item) {
+				return std::make_pair(item.layer->rank, item.source->archived);
+			});
+		}
+	}
+
+	_touched.clear();
+}
+
+void Era2VfsIndex::addToDirectory(const std::string& key, std::string_view path)
+{
+	const auto parentKey = std::string(parentOf(key));
+	const auto parent    = parentOf(path);
+
+	auto [it, inserted] = _directories.try_emplace(parentKey);
+	it->second.children.emplace(key);
+
+	if (!inserted || parentKey.empty())
+		return;
+
+	it->second.name = std::string(nameOf(parent));
+	addToDirectory(parentKey, parent);
+}
+
+void Era2VfsIndex::removeFromDirectory(const std::string& key)
+{
+	const auto parentKey = std::string(parentOf(key));
+
+	auto it = _directories.find(parentKey);
+	if (it == _directories.end())
+		return;
+
+	it->second.children.erase(key);
+
+	if (!it->second.children.empty())
+		return;
+
+	_directories.erase(it);
+
+	if (!parentKey.empty())
+		removeFromDirectory(parentKey);
+}
@@ -0,0 +1,113 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "era2_file_manifest_cache.hpp"
+#include "type/filesystem.hpp"
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace mm
+{
+	// physical file, which game loads for virtual one
+	struct Era2VfsSource
+	{
+		std::string mod;               // empty for game files
+		std::string path;              // relative to game directory, path to archive for archived files
+		bool        archived = false;  // file is an entry of archive at `path`
+	};
+
+	// Merged view of game directory as game sees it: files of enabled mods override each other
+	// in load order (first mod wins), loose file wins over archived one of same mod, game files are last.
+	// Lookups are case-insensitive, both '/' and '\\' separators are accepted.
+	// Only mods, which position was changed, are re-ranked when load order changes
+	class Era2VfsIndex
+	{
+	public:
+		struct Entry
+		{
+			std::string          name;
+			const Era2VfsSource* source = nullptr;  // nullptr for directories
+		};
+
+		Era2VfsIndex() = default;
+
+		// providers refer to layers, so index can be moved only
+		Era2VfsIndex(const Era2VfsIndex&)            = delete;
+		Era2VfsIndex(Era2VfsIndex&&)                 = default;
+		Era2VfsIndex& operator=(const Era2VfsIndex&) = delete;
+		Era2VfsIndex& operator=(Era2VfsIndex&&)      = default;
+
+		// `modPath` is path of mod directory relative to game directory
+		void setMod(const std::string& mod, const fs::path& modPath, const Era2FileManifest& manifest);
+		void setGame(const Era2FileManifest& manifest);
+		void removeMod(const std::string& mod);
+		bool contains(const std::string& mod) const;  // game is ""
+
+		// mods, which aren't listed, don't provide files
+		void setOrder(const std::vector<std::string>& enabled);
+
+		const Era2VfsSource*              find(std::string_view path) const;
+		std::vector<const Era2VfsSource*> sources(std::string_view path) const;  // winner first
+		std::vector<Entry>                list(std::string_view directory) const;  // sorted by name
+
+		size_t size() const;
+
+	private:
+		struct LayerFile
+		{
+			std::string   key;   // folded virtual path
+			std::string   path;  // virtual path
+			Era2VfsSource source;
+		};
+
+		struct Layer
+		{
+			std::vector<LayerFile> files;
+			size_t                 rank = size_t(-1);  // not attached if -1
+		};
+
+		struct Provider
+		{
+			const Layer*         layer;
+			const Era2VfsSource* source;
+		};
+
+		struct File
+		{
+			std::string           path;  // as first seen
+			std::vector<Provider> providers;
+		};
+
+		struct Directory
+		{
+			std::string                     name;
+			std::unordered_set<std::string> children;  // folded paths of files and directories
+		};
+
+		void setLayer(const std::string& mod, std::vector<LayerFile> files);
+		void attach(Layer& layer, size_t rank);
+		void detach(Layer& layer);
+		void rerank(Layer& layer, size_t rank);
+		void sortTouched();
+
+		void addToDirectory(const std::string& key, std::string_view path);
+		void removeFromDirectory(const std::string& key);
+
+	private:
+		std::unordered_map<std::string, Layer>  _layers;  // [mod] -> files, game is ""
+		std::unordered_map<std::string, size_t> _ranks;   // [mod] -> position in load order
+
+		std::unordered_map<std::string, File>      _files;        // [folded path] -> providers
+		std::unordered_map<std::string, Directory> _directories;  // [folded path] -> content, root is ""
+
+		std::unordered_set<std::string> _touched;  // files, which providers should be sorted
+	};
+}
@@ -24,6 +24,7 @@ namespace mm
 
 		[[nodiscard]] virtual fs::path getDataPath() const = 0;
 		[[nodiscard]] virtual fs::path getTempPath() const = 0;
+		[[nodiscard]] virtual fs::path getCachePath() const = 0;
 
 		[[nodiscard]] virtual ConflictResolveMode conflictResolveMode() const                    = 0;
 		virtual void                              conflictResolveMode(ConflictResolveMode value) = 0;
@@ -5,6 +5,9 @@
 
 #pragma once
 
+#include "domain/mod_id.hpp"
+
+#include <memory>
 #include <string>
 
 namespace mm
@@ -16,6 +19,14 @@ namespace mm
 		virtual ~IModDataProvider() = default;
 
 		[[nodiscard]] virtual const ModData&     modData(const std::string& id)     = 0;
+		[[nodiscard]] virtual const ModData&     modData(ModId id)                  = 0;
 		[[nodiscard]] virtual const std::string& description(const std::string& id) = 0;
+		[[nodiscard]] virtual const std::string& description(ModId id)              = 0;
+
+		// all ids in provided data belong to this table
+		[[nodiscard]] virtual const std::shared_ptr<ModIdTable>& modIds() const = 0;
+
+		// changes every time when previously loaded data is dropped
+		[[nodiscard]] virtual size_t generation() const = 0;
 	};
 }
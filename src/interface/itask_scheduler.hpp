@@ -0,0 +1,41 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "utility/task_handle.hpp"
+
+#include <functional>
+#include <stop_token>
+
+namespace mm
+{
+	enum class TaskPriority
+	{
+		interactive,  // user waits for result
+		background,   // i/o, which can be delayed
+	};
+
+	struct ITaskScheduler
+	{
+		using Task         = std::function<void(std::stop_token)>;
+		using Continuation = std::function<void()>;
+
+		virtual ~ITaskScheduler() = default;
+
+		// task is run on worker, continuation (if any) is called on ui thread after it,
+		// unless task is canceled. Exception thrown by task is rethrown on ui thread instead of continuation
+		[[nodiscard]] virtual TaskHandle run(
+			TaskPriority priority, Task task, Continuation continuation = {}) = 0;
+
+		// calls function on ui thread
+		virtual void post(Continuation continuation) = 0;
+
+		// calls body for each index in [0, count) on workers and calling thread, returns when all are done.
+		// Calling thread takes part in work, so it's safe to call it from task
+		virtual void forEach(
+			TaskPriority priority, size_t count, const std::function<void(size_t)>& body) = 0;
+	};
+}
@@ -10,6 +10,7 @@
 #include "service/app_config.hpp"
 #include "service/i18n_service.h"
 #include "service/platform_service.h"
+#include "service/task_scheduler.hpp"
 #include "system_info.hpp"
 #include "type/update_check_mode.hpp"
 #include "ui/main_frame.h"
@@ -35,7 +36,8 @@ ModManagerApp::ModManagerApp()
 	SetAppName(wxString::FromUTF8(PROGRAM_NAME));
 	wxStandardPaths::Get().IgnoreAppSubDir(L"release-static");
 	wxStandardPaths::Get().IgnoreAppSubDir(L"debug-asan");
-	_updateHelper = std::make_unique<UpdateCheckHelper>();
+	_taskScheduler = std::make_unique<TaskScheduler>();
+	_updateHelper  = std::make_unique<UpdateCheckHelper>(*_taskScheduler);
 }
 
 bool ModManagerApp::OnInit()
@@ -50,6 +52,14 @@ bool ModManagerApp::OnInit()
 	wxInitAllImageHandlers();
 	initServices();
 
+	if (_benchmark)
+	{
+		const auto output = Benchmark::run(*this, *_benchmark);
+		wxMessageOutputStderr().Printf(L"%s\n", wxString::FromUTF8(output.string()));
+
+		return false;  // nothing else to do
+	}
+
 	_singleInstanceChecker = std::make_unique<wxSingleInstanceChecker>();
 
 	bool alreadyRunning = false;
@@ -147,6 +157,33 @@ void ModManagerApp::OnInitCmdLine(wxCmdLineParser& parser)
 
 	parser.AddParam(wxEmptyString, wxCMD_LINE_VAL_STRING,
 		wxCMD_LINE_PARAM_OPTIONAL);  // ignore 1 param for now (should be changed in the future)
+
+	// used to track performance, synthetic mods are generated inside of given directory
+	parser.AddOption(wxEmptyString, L"benchmark", wxEmptyString, wxCMD_LINE_VAL_STRING, wxCMD_LINE_HIDDEN);
+	parser.AddOption(
+		wxEmptyString, L"benchmark-mods", wxEmptyString, wxCMD_LINE_VAL_NUMBER, wxCMD_LINE_HIDDEN);
+	parser.AddOption(
+		wxEmptyString, L"benchmark-iterations", wxEmptyString, wxCMD_LINE_VAL_NUMBER, wxCMD_LINE_HIDDEN);
+}
+
+bool ModManagerApp::OnCmdLineParsed(wxCmdLineParser& parser)
+{
+	if (!wxApp::OnCmdLineParsed(parser))
+		return false;
+
+	if (wxString dir; parser.Found(L"benchmark", &dir))
+	{
+		_benchmark          = Benchmark::Options();
+		_benchmark->workDir = fs::path(dir.ToStdWstring());
+
+		if (long value = 0; parser.Found(L"benchmark-mods", &value) && value > 0)
+			_benchmark->install.mods = static_cast<size_t>(value);
+
+		if (long value = 0; parser.Found(L"benchmark-iterations", &value) && value > 0)
+			_benchmark->iterations = static_cast<size_t>(value);
+	}
+
+	return true;
 }
 
 int ModManagerApp::OnExit()
@@ -181,6 +218,11 @@ IPlatformService& ModManagerApp::platformService() const
 	return *_platformService;
 }
 
+ITaskScheduler& ModManagerApp::taskScheduler() const
+{
+	return *_taskScheduler;
+}
+
 void ModManagerApp::scheduleRestart()
 {
 	CallAfter([this] {
@@ -204,15 +246,18 @@ void ModManagerApp::initServices()
 void ModManagerApp::requestUpdateCheck(bool automatic)
 {
 	_updateHelper->checkForUpdate([=](nlohmann::json update) {
-		CallAfter([=] {
-			_appConfig->lastUpdateCheck(clock::now());
+		_appConfig->lastUpdateCheck(clock::now());
 
-			if (_mainFrame)
-				_mainFrame->updateCheckCompleted(update, automatic);
-		});
+		if (_mainFrame)
+			_mainFrame->updateCheckCompleted(update, automatic);
 	});
 }
 
+const UpdateCheckHelper& ModManagerApp::updateCheckHelper() const
+{
+	return *_updateHelper;
+}
+
 wxString operator""_lng(const char* s, std::size_t)
 {
 	return wxString::FromUTF8(wxGetApp().translationString(s));
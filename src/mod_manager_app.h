@@ -8,8 +8,11 @@
 #include <wx/app.h>
 
 #include "application.h"
+#include "benchmark/benchmark_runner.hpp"
 #include "utility/wx_widgets_ptr.hpp"
 
+#include <optional>
+
 class wxSingleInstanceChecker;
 
 namespace mm
@@ -17,6 +20,7 @@ namespace mm
 	struct IAppConfig;
 	struct I18nService;
 	struct IPlatformService;
+	struct ITaskScheduler;
 	struct IIconStorage;
 	struct UpdateCheckHelper;
 	class MainFrame;
@@ -30,15 +34,19 @@ namespace mm
 		int OnExit() override;
 		void OnUnhandledException() override;
 		void OnInitCmdLine(wxCmdLineParser& parser) override;
+		bool OnCmdLineParsed(wxCmdLineParser& parser) override;
 
 		IAppConfig&       appConfig() const override;
 		II18nService&     i18nService() const override;
 		IPlatformService& platformService() const override;
+		ITaskScheduler&   taskScheduler() const override;
 
 		void scheduleRestart();
 		void initServices();
 		void requestUpdateCheck(bool automatic = false);
 
+		const UpdateCheckHelper& updateCheckHelper() const;
+
 		std::string translationString(const std::string& key) const;
 		std::string categoryTranslationString(const std::string& key) const;
 
@@ -55,7 +63,10 @@ namespace mm
 		std::unique_ptr<I18nService>      _i18nService;
 		std::unique_ptr<IPlatformService> _platformService;
 
+		std::unique_ptr<ITaskScheduler>    _taskScheduler;  // outlives restarts, unlike other services
 		std::unique_ptr<UpdateCheckHelper> _updateHelper;
+
+		std::optional<Benchmark::Options> _benchmark;  // requested from command line, no ui is shown then
 	};
 }
 
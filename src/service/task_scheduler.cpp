@@ -0,0 +1,211 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#include "stdafx.h"
+
+#include "task_scheduler.hpp"
+
+#include <wx/app.h>
+
+#include <atomic>
+#include <exception>
+#include <optional>
+
+using namespace mm;
+
+TaskScheduler::TaskScheduler(size_t workers)
+	: _workers(std::max<size_t>(workers, 1))
+	, _backgroundLimit(std::max<size_t>(_workers - 1, 1))
+{
+	for (size_t i = 0; i < _workers; ++i)
+		_threads.emplace_back(std::bind_front(&TaskScheduler::work, this));
+}
+
+TaskScheduler::~TaskScheduler()
+{
+	for (auto& item : _threads)
+		item.request_stop();
+
+	_wakeUp.notify_all();
+	_threads.clear();
+
+	// nobody will run them, but their handles may still wait
+	for (auto* queue : { &_interactive, &_background })
+		for (auto& entry : *queue)
+			if (entry.state->begin())
+				entry.state->finish();
+}
+
+size_t TaskScheduler::defaultWorkerCount()
+{
+	// at least one worker for background tasks and one for interactive ones
+	return std::clamp<size_t>(std::thread::hardware_concurrency(), 2, 16);
+}
+
+TaskHandle TaskScheduler::run(TaskPriority priority, Task task, Continuation continuation)
+{
+	auto state = std::make_shared<TaskHandle::State>();
+
+	{
+		std::lock_guard lock(_mutex);
+
+		auto& queue = priority == TaskPriority::interactive ? _interactive : _background;
+		queue.emplace_back(priority, std::move(task), std::move(continuation), state);
+	}
+
+	_wakeUp.notify_all();
+
+	return TaskHandle(std::move(state));
+}
+
+void TaskScheduler::post(Continuation continuation)
+{
+	if (wxTheApp)
+		wxTheApp->CallAfter(std::move(continuation));
+}
+
+void TaskScheduler::forEach(TaskPriority priority, size_t count, const std::function<void(size_t)>& body)
+{
+	// every participant owns contiguous part of range and takes items from its front, so neighbour items
+	// (usually related) are processed by same thread; participant out of work steals from back of others
+	struct Part
+	{
+		std::mutex mutex;
+		size_t     begin = 0;
+		size_t     end   = 0;
+	};
+
+	const size_t      participants = std::min(count, _workers + 1);
+	std::vector<Part> parts(participants);
+
+	for (size_t i = 0; i < participants; ++i)
+	{
+		parts[i].begin = count * i / participants;
+		parts[i].end   = count * (i + 1) / participants;
+	}
+
+	std::atomic_bool   failed = false;
+	std::mutex         errorAccess;
+	std::exception_ptr error;
+
+	auto take = [&](size_t self) -> std::optional<size_t> {
+		for (size_t i = 0; i < participants && !failed; ++i)
+		{
+			auto& part = parts[(self + i) % participants];
+
+			std::lock_guard lock(part.mutex);
+			if (part.begin == part.end)
+				continue;
+
+			return i == 0 ? part.begin++ : --part.end;
+		}
+
+		return {};
+	};
+
+	auto worker = [&](size_t self) {
+		try
+		{
+			while (const auto index = take(self))
+				body(*index);
+		}
+		catch (...)
+		{
+			std::lock_guard lock(errorAccess);
+			if (!error)
+				error = std::current_exception();
+
+			failed = true;
+		}
+	};
+
+	// parts of helpers, which aren't started when calling thread runs out of work, are stolen by it
+	std::vector<TaskHandle> helpers;
+	for (size_t i = 1; i < participants; ++i)
+		helpers.emplace_back(run(priority, [&worker, i](std::stop_token) { worker(i); }));
+
+	if (participants > 0)
+		worker(0);
+
+	for (auto& item : helpers)
+	{
+		item.cancel();
+		item.wait();
+	}
+
+	if (error)
+		std::rethrow_exception(error);
+}
+
+void TaskScheduler::work(std::stop_token token)
+{
+	while (true)
+	{
+		Entry entry;
+
+		{
+			std::unique_lock lock(_mutex);
+
+			const auto hasWork = [&] {
+				return !_interactive.empty() ||
+					   (!_background.empty() && _runningBackground < _backgroundLimit);
+			};
+
+			if (!_wakeUp.wait(lock, token, hasWork))
+				return;
+
+			auto& queue = !_interactive.empty() ? _interactive : _background;
+			entry       = std::move(queue.front());
+			queue.pop_front();
+
+			if (entry.priority == TaskPriority::background)
+				++_runningBackground;
+		}
+
+		execute(entry);
+
+		if (entry.priority == TaskPriority::background)
+		{
+			{
+				std::lock_guard lock(_mutex);
+				--_runningBackground;
+			}
+
+			_wakeUp.notify_all();
+		}
+	}
+}
+
+void TaskScheduler::execute(Entry& entry)
+{
+	auto& state = entry.state;
+	if (!state->begin())
+		return;
+
+	std::exception_ptr error;
+
+	try
+	{
+		entry.task(state->source.get_token());
+	}
+	catch (...)
+	{
+		error = std::current_exception();
+	}
+
+	// handle may be gone by the time ui thread gets to continuation, so stop is checked once more there
+	if (!state->source.stop_requested())
+	{
+		if (error)
+			post([error] { std::rethrow_exception(error); });
+		else if (entry.continuation)
+			post([state, continuation = std::move(entry.continuation)] {
+				if (!state->source.stop_requested())
+					continuation();
+			});
+	}
+
+	state->finish();
+}
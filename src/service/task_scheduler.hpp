@@ -0,0 +1,61 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "interface/itask_scheduler.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mm
+{
+	// Fixed set of workers shared by whole application. Interactive tasks are always taken first,
+	// background ones never occupy last worker, so interactive task doesn't wait for slow i/o
+	struct TaskScheduler : public ITaskScheduler
+	{
+		explicit TaskScheduler(size_t workers = defaultWorkerCount());
+		~TaskScheduler() override;  // tasks, which aren't started yet, are dropped
+
+		TaskScheduler(const TaskScheduler&)            = delete;
+		TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+		[[nodiscard]] TaskHandle run(
+			TaskPriority priority, Task task, Continuation continuation = {}) override;
+
+		void post(Continuation continuation) override;
+		void forEach(TaskPriority priority, size_t count, const std::function<void(size_t)>& body) override;
+
+		static size_t defaultWorkerCount();
+
+	private:
+		struct Entry
+		{
+			TaskPriority                       priority = TaskPriority::interactive;
+			Task                               task;
+			Continuation                       continuation;
+			std::shared_ptr<TaskHandle::State> state;
+		};
+
+		void work(std::stop_token token);
+		void execute(Entry& entry);
+
+	private:
+		const size_t _workers;
+		const size_t _backgroundLimit;
+
+		std::mutex                  _mutex;
+		std::condition_variable_any _wakeUp;
+		std::deque<Entry>           _interactive;           // guarded by _mutex
+		std::deque<Entry>           _background;            // guarded by _mutex
+		size_t                      _runningBackground = 0;  // guarded by _mutex
+
+		std::vector<std::jthread> _threads;  // last, so workers are stopped before queues are destroyed
+	};
+}
@@ -13,6 +13,8 @@
 
 #include <magic_enum.hpp>
 
+#include "domain/mod_id.hpp"
+
 class wxString;
 
 namespace mm
@@ -70,7 +72,7 @@ namespace mm
 		using GroupItemsBy       = std::variant<ManagedGroupTag, std::string, ArchivedGroupTag>;
 		using CategoryAndCaption = std::pair<GroupItemsBy, wxString>;
 
-		std::vector<std::string>        items;
+		std::vector<ModId>              items;
 		std::vector<CategoryAndCaption> categories;
 
 		struct GroupItemsByToStringVisitor
@@ -42,16 +42,16 @@ ConfigureMainListView::ConfigureMainListView(wxWindow* parent, IIconStorage& ico
 	bindEvents();
 
 	for (const auto& item : columns)
-		_mods.data.emplace_back(
-			std::string(magic_enum::enum_name(static_cast<ModListModelColumn>(std::abs(item)))),
+		_mods.add(
+			_modIds->intern(magic_enum::enum_name(static_cast<ModListModelColumn>(std::abs(item)))),
 			item > 0 ? ModList::ModState::enabled : ModList::ModState::disabled);
 
 	_listModel->modList(_mods);
 
 	std::unordered_set<std::string> items;
-	for (const auto& item : _mods.data)
+	for (const auto& item : _mods.data())
 		if (item.state == ModList::ModState::enabled)
-			items.emplace(item.id);
+			items.emplace(_mods.string(item.id));
 
 	_listModel->setChecked(items);
 }
@@ -61,14 +61,14 @@ std::vector<int> ConfigureMainListView::getColumns() const
 	std::vector<int> result;
 
 	const auto& checked = _listModel->getChecked();
-	for (const auto& item : _mods.data)
+	for (const auto& item : _mods.data())
 	{
-		const auto mlmc = magic_enum::enum_cast<ModListModelColumn>(item.id);
+		const auto mlmc = magic_enum::enum_cast<ModListModelColumn>(_mods.string(item.id));
 		if (!mlmc.has_value()) // hmm???
 			continue;
 
 		int i = static_cast<int>(mlmc.value());
-		if (!checked.contains(item.id))
+		if (!checked.contains(_mods.string(item.id)))
 			i = -i;
 
 		result.emplace_back(i);
@@ -254,7 +254,27 @@ const ModData& ConfigureMainListView::modData(const std::string& id)
 	return it->second;
 }
 
+const ModData& ConfigureMainListView::modData(ModId id)
+{
+	return modData(_modIds->string(id));
+}
+
 const std::string& mm::ConfigureMainListView::description(const std::string&)
 {
 	return _workaround;  // FIXME: refactor this piece of
 }
+
+const std::string& mm::ConfigureMainListView::description(ModId)
+{
+	return _workaround;
+}
+
+const std::shared_ptr<ModIdTable>& mm::ConfigureMainListView::modIds() const
+{
+	return _modIds;
+}
+
+size_t mm::ConfigureMainListView::generation() const
+{
+	return 0;
+}
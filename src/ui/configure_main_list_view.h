@@ -44,11 +44,17 @@ namespace mm
 		void buildLayout();
 
 		const ModData&     modData(const std::string& id) override;
+		const ModData&     modData(ModId id) override;
 		const std::string& description(const std::string& id) override;
+		const std::string& description(ModId id) override;
+		size_t             generation() const override;
+
+		const std::shared_ptr<ModIdTable>& modIds() const override;
 
 	private:
-		std::map<std::string, ModData> _data;
-		std::string                    _workaround;
+		const std::shared_ptr<ModIdTable> _modIds = std::make_shared<ModIdTable>();
+		std::map<std::string, ModData>    _data;
+		std::string                       _workaround;
 
 		const ModListModelManagedMode  _initialManagedMode;
 		const ModListModelArchivedMode _initialArchivedMode;
@@ -64,7 +70,7 @@ namespace mm
 		wxWidgetsPtr<wxButton>   _useLegacyArchivingButton   = nullptr;
 
 		wxObjectDataPtr<ModListModel> _listModel;
-		ModList                       _mods;
+		ModList                       _mods = ModList(_modIds);
 
 		wxWidgetsPtr<wxDataViewCtrl> _list = nullptr;
 
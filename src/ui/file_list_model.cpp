@@ -0,0 +1,155 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#include "stdafx.h"
+
+#include "file_list_model.hpp"
+
+#include "domain/mod_data.hpp"
+#include "icon_helper.hpp"
+#include "interface/iicon_storage.hpp"
+#include "interface/imod_data_provider.hpp"
+#include "type/icon.hpp"
+
+using namespace mm;
+
+FileListModel::FileListModel(IModDataProvider& modDataProvider, IIconStorage& iconStorage)
+	: wxDataViewVirtualListModel(0)
+	, _modDataProvider(modDataProvider)
+	, _iconStorage(iconStorage)
+{}
+
+unsigned int FileListModel::GetColumnCount() const
+{
+	return static_cast<unsigned int>(FileListModelColumn::total);
+}
+
+wxString FileListModel::GetColumnType(unsigned int col) const
+{
+	switch (static_cast<FileListModelColumn>(col))
+	{
+	case FileListModelColumn::game: return wxDataViewIconTextRenderer::GetDefaultType();
+	case FileListModelColumn::mods: return L"list";
+	case FileListModelColumn::index:
+	case FileListModelColumn::path: return wxDataViewTextRenderer::GetDefaultType();
+	case FileListModelColumn::total: break;
+	}
+
+	return wxEmptyString;
+}
+
+void FileListModel::GetValueByRow(wxVariant& variant, unsigned int row, unsigned int col) const
+{
+	if (row >= _data.entries.size())
+		return;
+
+	const auto& entry = _data.entries[row];
+
+	switch (static_cast<FileListModelColumn>(col))
+	{
+	case FileListModelColumn::index: variant = wxString(std::to_wstring(row + 1)); break;
+	case FileListModelColumn::game:
+	{
+		const auto icon = _gameFiles != Era2GameFiles::none
+							  ? entry.gamePath ? Icon::Stock::checkmark_green : Icon::Stock::cross_gray
+							  : Icon::Stock::question;
+
+		variant << wxDataViewIconText(L"", _iconStorage.get(icon, Icon::Size::x16));
+		break;
+	}
+	case FileListModelColumn::mods:
+	{
+		const auto missing = _iconStorage.get(Icon::Stock::cross_gray, Icon::Size::x16);
+
+		variant.NullList();
+
+		auto owner = entry.owners.cbegin();
+		for (size_t i = 0; i < _data.mods.size(); ++i)
+		{
+			if (owner != entry.owners.cend() && owner->mod == i)
+			{
+				++owner;
+				variant.Append(wxVariant(modIcon(i)));
+			}
+			else
+				variant.Append(wxVariant(missing));
+		}
+		break;
+	}
+	case FileListModelColumn::path: variant = wxString::FromUTF8(_data.paths[entry.filePath]); break;
+	case FileListModelColumn::total: break;
+	}
+}
+
+bool FileListModel::SetValueByRow(const wxVariant&, unsigned int, unsigned int)
+{
+	return false;
+}
+
+void FileListModel::reset(std::vector<std::string> mods, Era2GameFiles gameFiles)
+{
+	_data      = {};
+	_data.mods = std::move(mods);
+	_gameFiles = gameFiles;
+
+	Reset(0);
+}
+
+void FileListModel::append(Era2FileListBatch batch)
+{
+	std::ranges::move(batch.paths, std::back_inserter(_data.paths));
+
+	for (auto& [row, entry] : batch.rows)
+	{
+		if (row < _data.entries.size())
+		{
+			_data.entries[row] = std::move(entry);
+			RowChanged(static_cast<unsigned int>(row));
+		}
+		else
+		{
+			_data.entries.emplace_back(std::move(entry));
+			RowAppended();
+		}
+	}
+}
+
+void FileListModel::assign(Era2DirectoryStructure data)
+{
+	_data = std::move(data);
+
+	Reset(static_cast<unsigned int>(_data.entries.size()));
+}
+
+const Era2DirectoryStructure& FileListModel::data() const
+{
+	return _data;
+}
+
+const Era2FileEntry* FileListModel::findEntry(const wxDataViewItem& item) const
+{
+	if (!item.IsOk())
+		return nullptr;
+
+	const auto row = GetRow(item);
+
+	return row < _data.entries.size() ? &_data.entries[row] : nullptr;
+}
+
+const wxBitmap& FileListModel::modIcon(size_t mod) const
+{
+	const auto& id = _data.mods[mod];
+
+	auto it = _modIcons.find(id);
+	if (it == _modIcons.cend())
+	{
+		const auto& data = _modDataProvider.modData(id);
+
+		std::tie(it, std::ignore) =
+			_modIcons.emplace(id, loadModIcon(_iconStorage, data.data_path, data.icon, Icon::Size::x16));
+	}
+
+	return it->second;
+}
@@ -0,0 +1,64 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "era2/era2_mod_files.hpp"
+
+#include <wx/bitmap.h>
+#include <wx/dataview.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mm
+{
+	struct IIconStorage;
+	struct IModDataProvider;
+
+	enum class FileListModelColumn
+	{
+		index = 0,
+		game  = 1,
+		mods  = 2,
+		path  = 3,
+
+		total = path + 1,
+	};
+
+	// Rows of file list are rendered on demand, so list can be filled while mods are still being scanned
+	class FileListModel : public wxDataViewVirtualListModel
+	{
+	public:
+		FileListModel(IModDataProvider& modDataProvider, IIconStorage& iconStorage);
+
+		unsigned int GetColumnCount() const override;
+		wxString     GetColumnType(unsigned int col) const override;
+
+		void GetValueByRow(wxVariant& variant, unsigned int row, unsigned int col) const override;
+		bool SetValueByRow(const wxVariant& variant, unsigned int row, unsigned int col) override;
+
+		// starts new list, batches of listModFiles refer to `mods`
+		void reset(std::vector<std::string> mods, Era2GameFiles gameFiles);
+		void append(Era2FileListBatch batch);
+		void assign(Era2DirectoryStructure data);
+
+		const Era2DirectoryStructure& data() const;
+		const Era2FileEntry*          findEntry(const wxDataViewItem& item) const;
+
+	private:
+		const wxBitmap& modIcon(size_t mod) const;
+
+	private:
+		IModDataProvider& _modDataProvider;
+		IIconStorage&     _iconStorage;
+
+		Era2DirectoryStructure _data;
+		Era2GameFiles          _gameFiles = Era2GameFiles::none;
+
+		mutable std::unordered_map<std::string, wxBitmap> _modIcons;  // [mod id] -> icon
+	};
+}
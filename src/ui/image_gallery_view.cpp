@@ -7,7 +7,8 @@
 
 #include "image_gallery_view.hpp"
 
-#include "application.h"
+#include "interface/itask_scheduler.hpp"
+#include "mod_manager_app.h"
 #include "utility/wx_current_dir_helper.hpp"
 
 #include <wx/generic/statbmpg.h>
@@ -43,6 +44,10 @@ ImageGalleryView::ImageGalleryView(wxWindow* parent, wxWindowID winid, const fs:
 
 	Bind(wxEVT_SHOW, [=](const wxShowEvent&) { Reload(); });
 
+	// images are shown as soon as they're loaded
+	_progressTimer.SetOwner(this);
+	Bind(wxEVT_TIMER, [=](wxTimerEvent&) { updateProgress(); });
+
 	SetPath(directory);
 }
 
@@ -63,7 +68,7 @@ void ImageGalleryView::Reload()
 
 	if (!fs::exists(_path) || !IsShown())
 	{
-		CallAfter([=] { createImageControls(); });
+		CallAfter([=] { createImageControls(0); });
 		return;
 	}
 
@@ -77,23 +82,29 @@ void ImageGalleryView::Reload()
 
 void ImageGalleryView::start()
 {
-	_future = std::async(std::launch::async, [=] { loadInBackground(); });
+	_progress.reset(_images.size());
+	_progressTimer.Start(1000 / 10);
+
+	_task = wxGetApp().taskScheduler().run(
+		TaskPriority::interactive, std::bind_front(&ImageGalleryView::loadInBackground, this), [=] {
+			_progressTimer.Stop();
+			createImageControls(_images.size());
+		});
 }
 
-void ImageGalleryView::createImageControls()
+void ImageGalleryView::createImageControls(size_t loaded)
 {
 	{
 		std::lock_guard lg(_dataAccess);
 
-		_gallerySizer->Clear();
-		for (auto& item : _galleryImages)
-			item->Destroy();
-
-		_galleryImages.clear();
-
+		// images are loaded in order, so controls of shown ones are kept and new ones are appended
 		auto cursor = wxCursor(wxStockCursor::wxCURSOR_HAND);
-		for (const auto& item : _images)
+		for (; _shownImages < std::min(loaded, _images.size()); ++_shownImages)
 		{
+			const auto& item = _images[_shownImages];
+			if (!item.second.IsOk())
+				continue;
+
 			auto control = new wxGenericStaticBitmap(this, wxID_ANY, item.second);
 
 			_galleryImages.emplace_back(control);
@@ -113,35 +124,43 @@ void ImageGalleryView::createImageControls()
 
 void ImageGalleryView::stopWork()
 {
-	_canceled = true;
-	if (_future.valid())
-		_future.wait();
+	_progressTimer.Stop();
+
+	_task.cancel();
+	_task.wait();
 }
 
-void ImageGalleryView::loadInBackground()
+void ImageGalleryView::loadInBackground(std::stop_token token)
 {
-	_canceled = false;
-
 	if (!IsShown())
 		return;
 
-	for (size_t i = 0; !_canceled && i < _images.size(); ++i)
+	// list itself isn't changed until work is stopped, so lock is taken only to store result
+	for (size_t i = 0; !token.stop_requested() && i < _images.size(); ++i)
 	{
-		std::lock_guard<std::mutex> lock(_dataAccess);
-
 		wxImage item;
 		item.LoadFile(wxString::FromUTF8(_images[i].first.string()));
 
-		if (!item.IsOk())
-			continue;
+		if (item.IsOk())
+		{
+			const wxSize bestSize(getBestSize(item.GetSize(), defaultScreenHeight));
+			item.Rescale(bestSize.GetWidth(), bestSize.GetHeight(), wxIMAGE_QUALITY_NORMAL);
 
-		const wxSize bestSize(getBestSize(item.GetSize(), defaultScreenHeight));
-		item.Rescale(bestSize.GetWidth(), bestSize.GetHeight(), wxIMAGE_QUALITY_NORMAL);
+			std::lock_guard<std::mutex> lock(_dataAccess);
+			_images[i].second = wxBitmap(item);
+		}
 
-		_images[i].second = wxBitmap(item);
+		_progress.advance();
 	}
+}
+
+void ImageGalleryView::updateProgress()
+{
+	const auto loaded = static_cast<size_t>(_progress.read().done);
+	if (loaded == _shownImages)
+		return;
 
-	CallAfter([=] { createImageControls(); });
+	createImageControls(loaded);
 }
 
 void ImageGalleryView::Reset()
@@ -150,6 +169,7 @@ void ImageGalleryView::Reset()
 
 	std::lock_guard<std::mutex> lock(_dataAccess);
 	_images.clear();
+	_shownImages = 0;
 
 	if (_gallerySizer)
 		_gallerySizer->Clear();
@@ -6,12 +6,14 @@
 #pragma once
 
 #include "type/filesystem.hpp"
+#include "utility/progress_channel.hpp"
+#include "utility/task_handle.hpp"
 #include "utility/wx_widgets_ptr.hpp"
 
-#include <future>
 #include <mutex>
 
 #include <wx/scrolwin.h>
+#include <wx/timer.h>
 
 class wxWrapSizer;
 class wxGenericStaticBitmap;
@@ -31,17 +33,20 @@ namespace mm
 		void Reload();
 
 	private:
-		void createImageControls();
+		void createImageControls(size_t loaded);  // for images in [_shownImages, loaded)
 		void stopWork();
 		void start();
-		void loadInBackground();
+		void loadInBackground(std::stop_token token);
+		void updateProgress();
 
 	private:
 		fs::path _path;
 
 		mutable std::mutex _dataAccess;
-		std::future<void>  _future;
-		std::atomic_bool   _canceled   = false;
+		TaskHandle         _task;
+		ProgressChannel    _progress;  // loaded images
+		wxTimer            _progressTimer;
+		size_t             _shownImages = 0;  // images, which already have controls (if loaded)
 
 		std::vector<std::pair<fs::path, wxBitmap>>       _images;
 		wxWidgetsPtr<wxWrapSizer>                        _gallerySizer = nullptr;
@@ -30,6 +30,7 @@
 #include "system_info.hpp"
 #include "type/icon.hpp"
 #include "type/main_window_properties.h"
+#include "utility/program_update_helper.hpp"
 #include "utility/sdlexcept.h"
 #include "utility/wx_current_dir_helper.hpp"
 #include "type/program_version.hpp"
@@ -37,6 +38,7 @@
 #include <wx/aboutdlg.h>
 #include <wx/aui/auibook.h>
 #include <wx/busyinfo.h>
+#include <wx/filename.h>
 #include <wx/infobar.h>
 #include <wx/menu.h>
 #include <wx/notifmsg.h>
@@ -99,6 +101,7 @@ MainFrame::MainFrame(Application& app)
 
 	Bind(wxEVT_CLOSE_WINDOW, &MainFrame::OnCloseWindow, this);
 	Bind(wxEVT_TIMER, [=](wxTimerEvent&) { _infoBar->Dismiss(); });
+	_updateCheckTimer.Bind(wxEVT_TIMER, [=](wxTimerEvent&) { showUpdateCheckProgress(); });
 
 	_infoBar->Bind(wxEVT_BUTTON, [=](wxCommandEvent& event) {
 		if (event.GetId() == wxID_OPEN)
@@ -291,8 +294,9 @@ void MainFrame::OnMenuModListModFiles()
 {
 	EX_TRY;
 
-	ShowFileListDialog sfld(this, *_iconStorage, *_currentPlatform->modDataProvider(),
-		_currentPlatform->modManager()->mods(), _currentPlatform->managedPath());
+	ShowFileListDialog sfld(this, *_iconStorage, *_currentPlatform->modDataProvider(), _app.taskScheduler(),
+		_currentPlatform->modManager()->mods(), _currentPlatform->managedPath(),
+		_currentPlatform->localConfig()->getCachePath());
 	sfld.ShowModal();
 
 	EX_UNEXPECTED;
@@ -386,9 +390,42 @@ void MainFrame::OnMenuCheckForUpdates()
 
 	wxGetApp().requestUpdateCheck();
 
+	// user waits for result, so it's shown how much of response is already received
+	for (const auto& id : { wxID_DOWN, wxID_OPEN, wxID_CLOSE })
+		if (_infoBar->HasButtonId(id))
+			_infoBar->RemoveButton(id);
+
+	_infoBarTimer.Stop();
+	showUpdateCheckProgress();
+	_updateCheckTimer.Start(1000 / 10);
+
 	EX_UNEXPECTED;
 }
 
+void MainFrame::showUpdateCheckProgress()
+{
+	const auto& helper = wxGetApp().updateCheckHelper();
+
+	if (!helper.running())
+	{
+		_updateCheckTimer.Stop();
+		return;
+	}
+
+	const auto progress = helper.progress().read();
+
+	wxString received;
+	if (progress.done > 0)
+	{
+		received = wxFileName::GetHumanReadableSize(wxULongLong(progress.done));
+
+		if (progress.total > 0)
+			received += L" / " + wxFileName::GetHumanReadableSize(wxULongLong(progress.total));
+	}
+
+	_infoBar->ShowMessage(wxString::Format("message/notification/checking_for_update"_lng, received));
+}
+
 void MainFrame::OnCloseWindow(wxCloseEvent& event)
 {
 	saveWindowProperties();
@@ -448,6 +485,8 @@ void MainFrame::onLaunchGameRequested()
 
 void MainFrame::updateCheckCompleted(const nlohmann::json& value, bool automatic)
 {
+	_updateCheckTimer.Stop();
+
 	for (const auto& id : { wxID_DOWN, wxID_OPEN, wxID_CLOSE })
 		if (_infoBar->HasButtonId(id))
 			_infoBar->RemoveButton(id);
@@ -40,6 +40,7 @@ namespace mm
 		void OnMenuToolsChangeSettings();
 		void OnMenuToolsLanguageSelected(const std::string& value);
 		void OnMenuCheckForUpdates();
+		void showUpdateCheckProgress();
 		void OnMenuModListModFiles();
 		void OnMenuModOpenModFolder();
 		void OnMenuModCreateNewMod();
@@ -59,6 +60,7 @@ namespace mm
 
 		wxWidgetsPtr<wxInfoBarGeneric> _infoBar = nullptr;
 		wxTimer                        _infoBarTimer;
+		wxTimer                        _updateCheckTimer;  // polls progress of manual update check
 		wxString                       _newVersionUrl;
 
 		wxWidgetsPtr<wxMenuBar>              _mainMenu = nullptr;
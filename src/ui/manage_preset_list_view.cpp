@@ -352,7 +352,7 @@ void ManagePresetListView::updatePreview()
 		// mods.available = _platform.modManager()->mods().available;
 	}
 
-	_listModel->modList(ModList(preset.mods));
+	_listModel->modList(ModList(preset.mods, _platform.modDataProvider()->modIds()));
 
 	EX_UNEXPECTED;
 }
@@ -19,6 +19,7 @@
 #include "utility/sdlexcept.h"
 
 #include <boost/locale.hpp>
+#include <boost/algorithm/string/case_conv.hpp>
 #include <boost/algorithm/string/predicate.hpp>
 #include <wx/app.h>
 #include <wx/msgdlg.h>
@@ -29,25 +30,100 @@ namespace
 {
 	static constexpr auto categoryLimit = 1'000'000;
 
-	enum class ItemType
+	// keys, which compare bytewise same way as strings compare in current locale (case is ignored)
+	class SortKeyBuilder
 	{
-		container = 0,
-		item      = 1,
+	public:
+		SortKeyBuilder()
+		{
+			if (std::has_facet<boost::locale::collator<char>>(_locale))
+				_collator = &std::use_facet<boost::locale::collator<char>>(_locale);
+		}
+
+		std::string operator()(const std::string& value) const
+		{
+			if (_collator)
+				return _collator->transform(boost::locale::collate_level::secondary, value);
+
+			// locale isn't generated by boost, there is no better option than plain case folding
+			return boost::algorithm::to_lower_copy(value, _locale);
+		}
+
+	private:
+		std::locale                           _locale;
+		const boost::locale::collator<char>* _collator = nullptr;
 	};
 
-	wxDataViewItem toDataViewItem(size_t index, ItemType type)
-	{
-		return wxDataViewItem(reinterpret_cast<void*>(static_cast<long>(type) * categoryLimit + index + 1));
-	}
+	// when too much is changed, it's cheaper for control to rebuild everything than to apply changes
+	constexpr size_t smallChangeLimit = 16;
 
-	std::pair<ItemType, size_t> fromDataViewItem(const wxDataViewItem& item)
+	// indexes of values, which form longest increasing subsequence
+	std::vector<size_t> longestIncreasingSubsequence(const std::vector<size_t>& values)
 	{
-		const auto casted = reinterpret_cast<size_t>(item.GetID()) - 1;
+		std::vector<size_t> tails;  // index of smallest tail of subsequence of each length
+		std::vector<size_t> previous(values.size(), static_cast<size_t>(-1));
+
+		for (size_t i = 0; i < values.size(); ++i)
+		{
+			const auto it = std::ranges::lower_bound(
+				tails, values[i], std::less<>(), [&](size_t index) { return values[index]; });
+
+			if (it != tails.begin())
+				previous[i] = *std::prev(it);
+
+			if (it == tails.end())
+				tails.emplace_back(i);
+			else
+				*it = i;
+		}
+
+		std::vector<size_t> result;
+		if (!tails.empty())
+		{
+			for (auto i = tails.back(); i != static_cast<size_t>(-1); i = previous[i])
+				result.emplace_back(i);
+		}
 
-		return { static_cast<ItemType>(casted / categoryLimit), casted % categoryLimit };
+		std::ranges::reverse(result);
+
+		return result;
 	}
 }
 
+enum class ModListModel::ItemType
+{
+	container = 0,
+	item      = 1,
+};
+
+wxDataViewItem ModListModel::toDataViewItem(size_t index, ItemType type) const
+{
+	if (type == ItemType::item)
+		return toDataViewItem(_displayed.items[index]);
+
+	return wxDataViewItem(reinterpret_cast<void*>(static_cast<long>(type) * categoryLimit + index + 1));
+}
+
+wxDataViewItem ModListModel::toDataViewItem(ModId id) const
+{
+	// items are identified by mod, not by row, so they survive reload
+	const auto key = static_cast<long>(ItemType::item) * categoryLimit + id.value + 1;
+
+	return wxDataViewItem(reinterpret_cast<void*>(static_cast<size_t>(key)));
+}
+
+std::pair<ModListModel::ItemType, size_t> ModListModel::fromDataViewItem(const wxDataViewItem& item) const
+{
+	const auto casted = reinterpret_cast<size_t>(item.GetID()) - 1;
+	const auto type   = static_cast<ItemType>(casted / categoryLimit);
+	const auto key    = casted % categoryLimit;
+
+	if (type == ItemType::item)
+		return { type, key < _rowOfMod.size() ? _rowOfMod[key] : NotDisplayed };
+
+	return { type, key };
+}
+
 ModListModel::ModListModel(IModDataProvider& modDataProvider, IIconStorage& iconStorage,
 	ModListModelManagedMode managedMode, ModListModelArchivedMode archivedMode,
 	std::optional<Icon::Size> iconSize)
@@ -56,6 +132,7 @@ ModListModel::ModListModel(IModDataProvider& modDataProvider, IIconStorage& icon
 	, _managedMode(managedMode)
 	, _archivedMode(archivedMode)
 	, _iconSize(iconSize)
+	, _list(modDataProvider.modIds())
 {
 	reload();
 }
@@ -109,39 +186,10 @@ wxDataViewItem ModListModel::GetParent(const wxDataViewItem& item) const
 {
 	const auto [type, row] = fromDataViewItem(item);
 
-	if (type == ItemType::container)
+	if (type == ItemType::container || row == NotDisplayed || _parents[row] == TopLevel)
 		return wxDataViewItem();
 
-	const auto pos = _list.position(_displayed.items[row]);
-
-	if (pos)
-	{
-		if (_managedMode == ModListModelManagedMode::as_flat_list)
-			return wxDataViewItem();
-	}
-	else
-	{
-		if (_archivedMode == ModListModelArchivedMode::as_flat_list)
-			return wxDataViewItem();
-	}
-
-	for (size_t i = 0; i < _displayed.categories.size(); ++i)
-	{
-		if (std::visit(
-				[&](auto&& arg) {
-					using T = std::decay_t<decltype(arg)>;
-					if constexpr (std::is_same_v<T, ModListDsplayedData::ManagedGroupTag>)
-						return pos.has_value();
-					else if constexpr (std::is_same_v<T, ModListDsplayedData::ArchivedGroupTag>)
-						return !pos.has_value();
-					else  // T == std::string
-						return _modDataProvider.modData(_displayed.items[row]).category == arg;
-				},
-				_displayed.categories[i].first))
-			return toDataViewItem(i, ItemType::container);
-	}
-
-	return wxDataViewItem();
+	return toDataViewItem(_parents[row], ItemType::container);
 }
 
 unsigned int ModListModel::GetChildren(const wxDataViewItem& item, wxDataViewItemArray& children) const
@@ -151,52 +199,16 @@ unsigned int ModListModel::GetChildren(const wxDataViewItem& item, wxDataViewIte
 		for (size_t i = 0; i < _displayed.categories.size(); ++i)
 			children.push_back(toDataViewItem(i, ItemType::container));
 
-		for (size_t i = 0; i < _displayed.items.size(); ++i)
-		{
-			if (_list.position(_displayed.items[i]))
-			{
-				if (_managedMode == ModListModelManagedMode::as_flat_list)
-					children.push_back(toDataViewItem(i, ItemType::item));
-			}
-			else
-			{
-				if (_archivedMode == ModListModelArchivedMode::as_flat_list)
-					children.push_back(toDataViewItem(i, ItemType::item));
-			}
-		}
+		for (const auto& index : _topLevelItems)
+			children.push_back(toDataViewItem(index, ItemType::item));
 
 		return children.size();
 	}
 
 	const auto [type, index] = fromDataViewItem(item);
 
-	std::visit(
-		[&](auto&& arg) {
-			using T = std::decay_t<decltype(arg)>;
-			if constexpr (std::is_same_v<T, ModListDsplayedData::ManagedGroupTag>)
-			{
-				for (size_t i = 0; i < _displayed.items.size(); ++i)
-					if (!_list.rest.contains(_displayed.items[i]))
-						children.push_back(toDataViewItem(i, ItemType::item));
-			}
-			else if constexpr (std::is_same_v<T, ModListDsplayedData::ArchivedGroupTag>)
-			{
-				for (size_t i = 0; i < _displayed.items.size(); ++i)
-					if (_list.rest.contains(_displayed.items[i]))
-						children.push_back(toDataViewItem(i, ItemType::item));
-			}
-			else  // T == std::string
-			{
-				for (size_t i = 0; i < _displayed.items.size(); ++i)
-				{
-					const bool show = _list.rest.contains(_displayed.items[i]);
-
-					if (show && _modDataProvider.modData(_displayed.items[i]).category == arg)
-						children.push_back(toDataViewItem(i, ItemType::item));
-				}
-			}
-		},
-		_displayed.categories[index].first);
+	for (const auto& child : _children[index])
+		children.push_back(toDataViewItem(child, ItemType::item));
 
 	return children.size();
 }
@@ -226,91 +238,62 @@ void ModListModel::GetValue(wxVariant& variant, const wxDataViewItem& item, unsi
 		return;
 	}
 
-	const auto& id       = _displayed.items[index];
-	const auto& mod      = _modDataProvider.modData(id);
-	const auto  position = _list.position(id);
+	// view may still ask for item, which was filtered out, until it's notified
+	if (index == NotDisplayed)
+		return;
+
+	const auto& row = _rows[index];
 
 	switch (static_cast<ModListModelColumn>(col))
 	{
 	case ModListModelColumn::priority:
 	{
-		wxBitmap icon;
-		wxString text;
-
-		if (position)
-		{
-			text = wxString::Format(L"%u", *position + 1);
-
-			const auto& icon_ = [&]() {
-				switch (*_list.state(id))
-				{
-				case ModList::ModState::enabled: return Icon::Stock::checkmark_green;
-				case ModList::ModState::disabled: return Icon::Stock::cross_gray;
-				}
-
-				return Icon::Stock::blank;
-			}();
-
-			icon = _iconStorage.get(icon_, _iconSize);
-		}
-
-		variant = wxVariant(wxDataViewIconText(text, icon));
+		variant = wxVariant(wxDataViewIconText(row.priority, row.stateIcon));
 		break;
 	}
 	case ModListModelColumn::name:
 	{
-		variant = wxVariant(wxDataViewIconText(
-			wxString::FromUTF8(mod.name), loadModIcon(_iconStorage, mod.data_path, mod.icon, _iconSize)));
+		variant = wxVariant(wxDataViewIconText(row.name, row.icon));
 		break;
 	}
 	case ModListModelColumn::support:
 	{
-		wxBitmap icon;
-		if (!mod.support.empty())
-			icon = _iconStorage.get(Icon::Stock::heart);
-
-		variant = wxVariant(wxBitmapBundle(icon));
+		variant = wxVariant(wxBitmapBundle(row.supportIcon));
 		break;
 	}
 	case ModListModelColumn::author:
 	{
-		variant = wxVariant(wxString::FromUTF8(mod.author));
+		variant = wxVariant(row.author);
 		break;
 	}
 	case ModListModelColumn::category:
 	{
-		variant = wxVariant(wxString::FromUTF8(wxGetApp().categoryTranslationString(mod.category)));
+		variant = wxVariant(row.category);
 		break;
 	}
 	case ModListModelColumn::version:
 	{
-		variant = wxVariant(wxString::FromUTF8(mod.version));
+		variant = wxVariant(row.version);
 		break;
 	}
 	case ModListModelColumn::directory:
 	{
-		variant = wxVariant(wxString::FromUTF8(mod.dir));
+		variant = wxVariant(row.directory);
 		break;
 	}
 	case ModListModelColumn::checkbox:
 	{
-		variant = wxVariant(_checked.contains(id));
+		variant = wxVariant(_checked.contains(_list.string(_displayed.items[index])));
 		break;
 	}
 	case ModListModelColumn::status:
 	{
-		variant = wxVariant(wxDataViewIconText(
-			L"", _iconStorage.get(
-					 position ? Icon::Stock::checkmark_green : Icon::Stock::cross_gray, _iconSize)));
+		variant = wxVariant(wxDataViewIconText(L"", row.statusIcon));
 		break;
 	}
 	case ModListModelColumn::load_order:
 	{
-		wxString value;
-		if (position)
-			value = wxString::Format(L"%u", *position);
-
-		variant = wxVariant(value);
+		variant = wxVariant(row.loadOrder);
 		break;
 	}
 	}
@@ -320,13 +303,13 @@ bool ModListModel::SetValue(const wxVariant&, const wxDataViewItem& item, unsign
 {
 	const auto [type, index] = fromDataViewItem(item);
 
-	if (type == ItemType::container)
+	if (type == ItemType::container || index == NotDisplayed)
 		return false;
 
 	switch (static_cast<ModListModelColumn>(col))
 	{
 	case ModListModelColumn::checkbox:
-		const auto& myItem = _displayed.items[index];
+		const auto& myItem = _list.string(_displayed.items[index]);
 
 		if (auto it = _checked.find(myItem); it != _checked.cend())
 			_checked.erase(it);
@@ -339,18 +322,21 @@ bool ModListModel::SetValue(const wxVariant&, const wxDataViewItem& item, unsign
 	return false;
 }
 
-bool ModListModel::GetAttr(const wxDataViewItem& item, unsigned int, wxDataViewItemAttr& attr) const
+bool ModListModel::GetAttr(const wxDataViewItem& item, unsigned int col, wxDataViewItemAttr& attr) const
 {
 	const auto [type, index] = fromDataViewItem(item);
-	if (type == ItemType::container)
+	if (type == ItemType::container || index == NotDisplayed)
 		return false;
 
-	const auto& mod = _displayed.items[index];
+	const auto& row = _rows[index];
 
-	if (_modDataProvider.modData(mod).virtual_mod)
+	if (row.virtualMod)
 		attr.SetBackgroundColour(wxColour(255, 127, 127));
 
-	return false;
+	if (static_cast<ModListModelColumn>(col) == ModListModelColumn::name && row.conflict)
+		attr.SetColour(wxColour(192, 64, 0));
+
+	return attr.HasBackgroundColour() || attr.HasColour();
 }
 
 int ModListModel::Compare(
@@ -360,13 +346,14 @@ int ModListModel::Compare(
 	const auto [type2, index2] = fromDataViewItem(item2);
 	const auto typedColumn     = static_cast<ModListModelColumn>(column);
 
-	auto compareName = [&]() {
-		const auto& left  = wxString::FromUTF8(_modDataProvider.modData(_displayed.items[index1]).name);
-		const auto& right = wxString::FromUTF8(_modDataProvider.modData(_displayed.items[index2]).name);
+	auto compareKeys = [&](const std::string& left, const std::string& right) {
+		const auto result = left.compare(right);
 
-		return ascending ? left.CmpNoCase(right) : right.CmpNoCase(left);
+		return (ascending ? 1 : -1) * ((result > 0) - (result < 0));
 	};
 
+	auto compareName = [&]() { return compareKeys(_rows[index1].nameKey, _rows[index2].nameKey); };
+
 	if (type1 != type2)
 	{
 		if (_managedMode == ModListModelManagedMode::as_flat_list)
@@ -378,14 +365,17 @@ int ModListModel::Compare(
 	if (type1 == ItemType::container)
 		return static_cast<ssize_t>(index1) - static_cast<ssize_t>(index2);
 
+	// items, which aren't displayed anymore, have no rows; keep them after displayed ones
+	if (index1 == NotDisplayed || index2 == NotDisplayed)
+		return (index1 == NotDisplayed) - (index2 == NotDisplayed);
+
 	if (static_cast<ModListModelColumn>(column) == ModListModelColumn::priority)
 	{
-		const auto pos1 = _list.position(_displayed.items[index1]);
-		const auto pos2 = _list.position(_displayed.items[index2]);
+		const auto& pos1 = _rows[index1].position;
+		const auto& pos2 = _rows[index2].position;
 
 		if (!pos1 && !pos2)
-			return wxDataViewModel::Compare(
-				item1, item2, static_cast<unsigned int>(ModListModelColumn::name), true);
+			return ascending ? compareName() : -compareName();  // always by name ascending
 
 		if (pos1 && pos2)
 			return ascending ? static_cast<ssize_t>(index1) - static_cast<ssize_t>(index2)
@@ -400,31 +390,21 @@ int ModListModel::Compare(
 	if (typedColumn == ModListModelColumn::name)
 		return compareName();
 
-	wxString left;
-	wxString right;
+	const std::string Row::*key = nullptr;
 
 	if (typedColumn == ModListModelColumn::category)
-	{
-		const auto& cat1 = _modDataProvider.modData(_displayed.items[index1]).category;
-		const auto& cat2 = _modDataProvider.modData(_displayed.items[index2]).category;
-
-		left  = wxString::FromUTF8(wxGetApp().categoryTranslationString(cat1));
-		right = wxString::FromUTF8(wxGetApp().categoryTranslationString(cat2));
-	}
+		key = &Row::categoryKey;
 	else if (typedColumn == ModListModelColumn::author)
-	{
-		left = wxString::FromUTF8(_modDataProvider.modData(_displayed.items[index1]).author);
-		right = wxString::FromUTF8(_modDataProvider.modData(_displayed.items[index2]).author);
-	}
+		key = &Row::authorKey;
 	else if (typedColumn == ModListModelColumn::directory)
+		key = &Row::directoryKey;
+
+	if (key)
 	{
-		left = wxString::FromUTF8(_modDataProvider.modData(_displayed.items[index1]).dir);
-		right = wxString::FromUTF8(_modDataProvider.modData(_displayed.items[index2]).dir);
+		if (auto res = compareKeys(_rows[index1].*key, _rows[index2].*key); res != 0)
+			return res;
 	}
 
-	if (auto res = ascending ? left.CmpNoCase(right) : right.CmpNoCase(left); res != 0)
-		return res;
-
 	if (auto res = wxDataViewModel::Compare(item1, item2, column, ascending); res != 0)
 		return res;
 
@@ -433,6 +413,8 @@ int ModListModel::Compare(
 
 void ModListModel::modList(const ModList& mods)
 {
+	MM_PRECONDTION(mods.ids == _modDataProvider.modIds());
+
 	_list = mods;
 	reload();
 }
@@ -448,9 +430,31 @@ const std::unordered_set<std::string>& ModListModel::getChecked() const
 	return _checked;
 }
 
-void ModListModel::applyFilter(const std::string& value)
+void ModListModel::setConflictMarks(std::unordered_set<ModId> items)
+{
+	_conflictMarks = std::move(items);
+
+	// rows are kept, control is notified only about marks, which were changed
+	for (size_t i = 0; i < _rows.size(); ++i)
+	{
+		const bool conflict = _conflictMarks.contains(_displayed.items[i]);
+		if (_rows[i].conflict == conflict)
+			continue;
+
+		_rows[i].conflict = conflict;
+		ItemChanged(toDataViewItem(i, ItemType::item));
+	}
+}
+
+void ModListModel::applyFilter(std::string query, std::shared_ptr<const ModSearchIndex> index,
+	std::unordered_set<std::string> matches)
 {
-	_filter = boost::locale::fold_case(value);
+	_filter        = std::move(query);
+	_filterMatches = std::move(matches);
+
+	if (index)
+		_searchIndex = std::move(index);
+
 	reload();
 }
 
@@ -460,23 +464,67 @@ void ModListModel::applyCategoryFilter(const std::set<std::string>& value)
 	reload();
 }
 
-bool ModListModel::passFilter(const std::string& id) const
+std::vector<ModSearchIndex::Source> ModListModel::searchIndexSources() const
+{
+	std::vector<ModSearchIndex::Source> result;
+	result.reserve(_list.data().size() + _list.rest().size());
+
+	auto add = [&](ModId id) {
+		const auto& mod = _modDataProvider.modData(id);
+
+		result.emplace_back(ModSearchIndex::Source { mod.id,
+			{ mod.dir, mod.name, mod.author, mod.category, mod.version }, mod.data_path / mod.description });
+	};
+
+	for (const auto& mod : _list.data())
+		add(mod.id);
+
+	for (const auto& mod : _list.rest())
+		add(mod);
+
+	return result;
+}
+
+void ModListModel::setSearchIndex(std::shared_ptr<const ModSearchIndex> index)
+{
+	// index gives same results as direct search, so there is no need to reload anything
+	_searchIndex = std::move(index);
+	updateFilterMatches();
+}
+
+const std::shared_ptr<const ModSearchIndex>& ModListModel::searchIndex() const
+{
+	return _searchIndex;
+}
+
+void ModListModel::updateFilterMatches()
+{
+	_filterMatches.clear();
+
+	if (_searchIndex && !_filter.empty())
+		_filterMatches = _searchIndex->find(_filter);
+}
+
+bool ModListModel::passFilter(ModId id) const
 {
 	// TODO: move into mod itself?
 
 	if (_filter.empty() && _categoryFilter.empty())
 		return true;
 
-	const auto& mod  = _modDataProvider.modData(id);
-	const auto& desc = _modDataProvider.description(mod.id);
+	const auto& mod = _modDataProvider.modData(id);
 
 	if (!_categoryFilter.empty() && _categoryFilter.contains(mod.category))
 		return false;
 
+	if (!_filter.empty() && _searchIndex && _searchIndex->contains(mod.id))
+		return _filterMatches.contains(mod.id);
+
 	if (!_filter.empty())
 	{
 		return std::ranges::any_of(
-			std::initializer_list { mod.dir, mod.name, mod.author, mod.category, mod.version, desc },
+			std::initializer_list { mod.dir, mod.name, mod.author, mod.category, mod.version,
+				_modDataProvider.description(id) },
 			[&](const std::string& from) {
 				return boost::contains(boost::locale::fold_case(from), _filter);
 			});
@@ -487,17 +535,47 @@ bool ModListModel::passFilter(const std::string& id) const
 
 void ModListModel::reload()
 {
-	_displayed.categories.clear();
-	_displayed.items.clear();
+	const auto displayedBefore = std::exchange(_displayed, {});
+	const auto rowsBefore      = std::exchange(_rows, {});
+	const auto parentsBefore   = std::exchange(_parents, {});
 
-	for (const auto& mod : _list.data)
+	for (const auto& mod : _list.data())
 		if (passFilter(mod.id))
 			_displayed.items.emplace_back(mod.id);
 
-	for (const auto& mod : _list.rest)
+	for (const auto& mod : _list.rest())
 		if (passFilter(mod))
 			_displayed.items.emplace_back(mod);
 
+	// translated once per category, not once per mod
+	// caption and sort key
+	std::unordered_map<std::string, std::pair<wxString, std::string>> categoryNames;
+
+	const SortKeyBuilder sortKey;
+
+	_rows.clear();
+	_rows.reserve(_displayed.items.size());
+
+	for (const auto& id : _displayed.items)
+	{
+		const auto& mod = _modDataProvider.modData(id);
+
+		auto it = categoryNames.find(mod.category);
+		if (it == categoryNames.cend())
+		{
+			const auto translated = wxGetApp().categoryTranslationString(mod.category);
+
+			std::tie(it, std::ignore) = categoryNames.emplace(
+				mod.category, std::make_pair(wxString::FromUTF8(translated), sortKey(translated)));
+		}
+
+		auto& row        = _rows.emplace_back(makeRow(id, it->second.first));
+		row.nameKey      = sortKey(mod.name);
+		row.authorKey    = sortKey(mod.author);
+		row.categoryKey  = it->second.second;
+		row.directoryKey = sortKey(mod.dir);
+	}
+
 	size_t                                  managedCount = 0;
 	std::unordered_map<std::string, size_t> cats;
 	size_t                                  archivedCount = 0;
@@ -529,8 +607,7 @@ void ModListModel::reload()
 	for (const auto& cat : cats)
 		_displayed.categories.emplace_back(cat.first,
 			wxString::Format(L"%s (%d)",
-				cat.first.empty() ? "column/without_category"_lng
-								  : wxString::FromUTF8(wxGetApp().categoryTranslationString(cat.first)),
+				cat.first.empty() ? "column/without_category"_lng : categoryNames[cat.first].first,
 				cat.second));
 
 	if (archivedCount)
@@ -560,7 +637,203 @@ void ModListModel::reload()
 			return left.second < right.second;
 		});
 
-	Cleared();
+	buildGroups();
+	notifyChanges(displayedBefore, rowsBefore, parentsBefore);
+}
+
+void ModListModel::notifyChanges(const ModListDsplayedData& displayedBefore,
+	const std::vector<Row>& rowsBefore, const std::vector<size_t>& parentsBefore)
+{
+	// containers are identified by index, so any change of groups requires full rebuild
+	if (!std::ranges::equal(displayedBefore.categories, _displayed.categories, {},
+			&ModListDsplayedData::CategoryAndCaption::first, &ModListDsplayedData::CategoryAndCaption::first))
+	{
+		Cleared();
+		return;
+	}
+
+	std::unordered_map<ModId, size_t> rowBefore;
+	for (size_t i = 0; i < displayedBefore.items.size(); ++i)
+		rowBefore.emplace(displayedBefore.items[i], i);
+
+	// item is kept, if it has same parent and its order relative to other kept items isn't changed,
+	// everything else is removed and added again
+	std::vector<bool> kept(_displayed.items.size());
+	std::vector<bool> keptBefore(displayedBefore.items.size());
+
+	auto keepUnmoved = [&](const std::vector<size_t>& children, size_t parent) {
+		std::vector<size_t> candidates;
+		std::vector<size_t> positionsBefore;
+
+		for (const auto& row : children)
+		{
+			const auto it = rowBefore.find(_displayed.items[row]);
+			if (it != rowBefore.cend() && parentsBefore[it->second] == parent)
+			{
+				candidates.emplace_back(row);
+				positionsBefore.emplace_back(it->second);
+			}
+		}
+
+		for (const auto& index : longestIncreasingSubsequence(positionsBefore))
+		{
+			kept[candidates[index]]             = true;
+			keptBefore[positionsBefore[index]] = true;
+		}
+	};
+
+	keepUnmoved(_topLevelItems, TopLevel);
+	for (size_t i = 0; i < _children.size(); ++i)
+		keepUnmoved(_children[i], i);
+
+	const auto removed = std::ranges::count(keptBefore, false);
+	const auto added   = std::ranges::count(kept, false);
+	const auto total   = std::max(displayedBefore.items.size(), _displayed.items.size());
+
+	if (static_cast<size_t>(removed + added) > std::max(smallChangeLimit, total / 2))
+	{
+		Cleared();
+		return;
+	}
+
+	auto parentItem = [&](size_t parent) {
+		return parent == TopLevel ? wxDataViewItem() : toDataViewItem(parent, ItemType::container);
+	};
+
+	for (size_t i = 0; i < displayedBefore.items.size(); ++i)
+		if (!keptBefore[i])
+			ItemDeleted(parentItem(parentsBefore[i]), toDataViewItem(displayedBefore.items[i]));
+
+	for (size_t i = 0; i < _displayed.items.size(); ++i)
+		if (!kept[i])
+			ItemAdded(parentItem(_parents[i]), toDataViewItem(i, ItemType::item));
+
+	for (size_t i = 0; i < _displayed.items.size(); ++i)
+		if (kept[i] && !_rows[i].sameAs(rowsBefore[rowBefore[_displayed.items[i]]]))
+			ItemChanged(toDataViewItem(i, ItemType::item));
+
+	for (size_t i = 0; i < _displayed.categories.size(); ++i)
+		if (displayedBefore.categories[i].second != _displayed.categories[i].second)
+			ItemChanged(toDataViewItem(i, ItemType::container));
+}
+
+void ModListModel::buildGroups()
+{
+	_rowOfMod.assign(_list.ids->size(), NotDisplayed);
+	for (size_t i = 0; i < _displayed.items.size(); ++i)
+		_rowOfMod[_displayed.items[i].value] = i;
+
+	_parents.assign(_displayed.items.size(), TopLevel);
+	_children.assign(_displayed.categories.size(), {});
+	_topLevelItems.clear();
+
+	std::optional<size_t>                   managedGroup;
+	std::optional<size_t>                   archivedGroup;
+	std::unordered_map<std::string, size_t> categoryGroups;
+
+	for (size_t i = 0; i < _displayed.categories.size(); ++i)
+	{
+		std::visit(
+			[&](auto&& arg) {
+				using T = std::decay_t<decltype(arg)>;
+				if constexpr (std::is_same_v<T, ModListDsplayedData::ManagedGroupTag>)
+					managedGroup = i;
+				else if constexpr (std::is_same_v<T, ModListDsplayedData::ArchivedGroupTag>)
+					archivedGroup = i;
+				else  // T == std::string
+					categoryGroups.emplace(arg, i);
+			},
+			_displayed.categories[i].first);
+	}
+
+	for (size_t i = 0; i < _displayed.items.size(); ++i)
+	{
+		std::optional<size_t> parent;
+
+		if (_rows[i].position)
+		{
+			if (_managedMode == ModListModelManagedMode::as_group)
+				parent = managedGroup;
+		}
+		else if (_archivedMode == ModListModelArchivedMode::as_single_group)
+		{
+			parent = archivedGroup;
+		}
+		else if (_archivedMode == ModListModelArchivedMode::as_individual_groups)
+		{
+			const auto& category = _modDataProvider.modData(_displayed.items[i]).category;
+
+			if (auto it = categoryGroups.find(category); it != categoryGroups.cend())
+				parent = it->second;
+		}
+
+		if (parent)
+		{
+			_parents[i] = *parent;
+			_children[*parent].emplace_back(i);
+		}
+		else
+		{
+			_topLevelItems.emplace_back(i);
+		}
+	}
+}
+
+bool ModListModel::Row::sameAs(const Row& other) const
+{
+	return position == other.position && state == other.state && virtualMod == other.virtualMod &&
+		   conflict == other.conflict && priority == other.priority && loadOrder == other.loadOrder &&
+		   name == other.name && author == other.author && category == other.category &&
+		   version == other.version && directory == other.directory && stateIcon.IsSameAs(other.stateIcon) &&
+		   icon.IsSameAs(other.icon) && supportIcon.IsSameAs(other.supportIcon) &&
+		   statusIcon.IsSameAs(other.statusIcon);
+}
+
+ModListModel::Row ModListModel::makeRow(ModId id, const wxString& category) const
+{
+	const auto& mod = _modDataProvider.modData(id);
+
+	Row result;
+	result.position   = _list.position(id);
+	result.state      = _list.state(id);
+	result.virtualMod = mod.virtual_mod;
+	result.conflict   = _conflictMarks.contains(id);
+
+	if (result.position)
+	{
+		result.priority  = wxString::Format(L"%u", *result.position + 1);
+		result.loadOrder = wxString::Format(L"%u", *result.position);
+	}
+
+	if (result.state)
+	{
+		const auto stateIcon = [&]() {
+			switch (*result.state)
+			{
+			case ModList::ModState::enabled: return Icon::Stock::checkmark_green;
+			case ModList::ModState::disabled: return Icon::Stock::cross_gray;
+			}
+
+			return Icon::Stock::blank;
+		}();
+
+		result.stateIcon = _iconStorage.get(stateIcon, _iconSize);
+	}
+
+	result.name      = wxString::FromUTF8(mod.name);
+	result.author    = wxString::FromUTF8(mod.author);
+	result.category  = category;
+	result.version   = wxString::FromUTF8(mod.version);
+	result.directory = wxString::FromUTF8(mod.dir);
+
+	result.icon = loadModIcon(_iconStorage, mod.data_path, mod.icon, _iconSize);
+	if (!mod.support.empty())
+		result.supportIcon = _iconStorage.get(Icon::Stock::heart);
+
+	result.statusIcon =
+		_iconStorage.get(result.position ? Icon::Stock::checkmark_green : Icon::Stock::cross_gray, _iconSize);
+
+	return result;
 }
 
 const ModData* ModListModel::findMod(const wxDataViewItem& item) const
@@ -569,7 +842,7 @@ const ModData* ModListModel::findMod(const wxDataViewItem& item) const
 		return nullptr;
 
 	const auto [type, index] = fromDataViewItem(item);
-	if (type == ItemType::container)
+	if (type == ItemType::container || index == NotDisplayed)
 		return nullptr;
 
 	return &_modDataProvider.modData(_displayed.items[index]);
@@ -577,11 +850,14 @@ const ModData* ModListModel::findMod(const wxDataViewItem& item) const
 
 wxDataViewItem ModListModel::findItemById(const std::string& id) const
 {
-	for (size_t i = 0; i < _displayed.items.size(); ++i)
-		if (_displayed.items[i] == id)
-			return toDataViewItem(i, ItemType::item);
+	const auto modId = _list.ids->find(id);
+	if (!modId)
+		return {};
 
-	return {};
+	if (modId->value >= _rowOfMod.size() || _rowOfMod[modId->value] == NotDisplayed)
+		return {};
+
+	return toDataViewItem(_rowOfMod[modId->value], ItemType::item);
 }
 
 std::string ModListModel::findIdByItem(const wxDataViewItem& item) const
@@ -590,10 +866,10 @@ std::string ModListModel::findIdByItem(const wxDataViewItem& item) const
 		return {};
 
 	const auto [type, index] = fromDataViewItem(item);
-	if (type == ItemType::container)
+	if (type == ItemType::container || index == NotDisplayed)
 		return {};
 
-	return _displayed.items[index];
+	return _list.string(_displayed.items[index]);
 }
 
 std::optional<ModListDsplayedData::GroupItemsBy> ModListModel::itemGroupByItem(
@@ -623,7 +899,7 @@ void ModListModel::setArchivedModsDisplay(ModListModelArchivedMode value)
 
 wxString ModListModel::status() const
 {
-	const size_t total     = _list.data.size() + _list.rest.size();
+	const size_t total     = _list.data().size() + _list.rest().size();
 	const size_t displayed = _displayed.items.size();
 	const auto   hidden    = total - displayed;
 
@@ -12,6 +12,7 @@
 #include <wx/dataview.h>
 
 #include "domain/mod_list.hpp"
+#include "domain/mod_search_index.hpp"
 #include "type/mod_list_model_structs.hpp"
 #include "utility/wx_widgets_ptr.hpp"
 
@@ -57,9 +58,20 @@ namespace mm
 		void                                   setChecked(std::unordered_set<std::string> items);
 		const std::unordered_set<std::string>& getChecked() const;
 
-		void applyFilter(const std::string& value);
+		// mods, enabling which would disable other mods; shown rows are updated in place
+		void setConflictMarks(std::unordered_set<ModId> items);
+
+		// query must be already folded, matches are result of search by index (found by caller,
+		// so typing doesn't block ui); index, if any, replaces current one
+		void applyFilter(std::string query, std::shared_ptr<const ModSearchIndex> index,
+			std::unordered_set<std::string> matches);
 		void applyCategoryFilter(const std::set<std::string>& value);
 
+		std::vector<ModSearchIndex::Source> searchIndexSources() const;
+		void                                setSearchIndex(std::shared_ptr<const ModSearchIndex> index);
+
+		const std::shared_ptr<const ModSearchIndex>& searchIndex() const;
+
 		const ModData*                                   findMod(const wxDataViewItem& item) const;
 		wxDataViewItem                                   findItemById(const std::string& id) const;
 		std::string                                      findIdByItem(const wxDataViewItem& item) const;
@@ -71,9 +83,54 @@ namespace mm
 		wxString status() const;
 
 	private:
-		bool passFilter(const std::string& id) const;
+		bool passFilter(ModId id) const;
+		void updateFilterMatches();
 
 		void reload();
+		void buildGroups();
+
+	private:
+		// everything, what is shown for displayed mod, so painting doesn't touch provider or translations
+		struct Row
+		{
+			std::optional<size_t>            position;
+			std::optional<ModList::ModState> state;
+			bool                             virtualMod = false;
+			bool                             conflict   = false;  // conflict marks at time of reload
+
+			wxString priority;  // 1-based position
+			wxString loadOrder;
+			wxString name;
+			wxString author;
+			wxString category;
+			wxString version;
+			wxString directory;
+
+			wxBitmap stateIcon;
+			wxBitmap icon;
+			wxBitmap supportIcon;
+			wxBitmap statusIcon;
+
+			// locale aware sort keys, compared bytewise
+			std::string nameKey;
+			std::string authorKey;
+			std::string categoryKey;
+			std::string directoryKey;
+
+			// sort keys are derived from shown values, so aren't compared
+			bool sameAs(const Row& other) const;
+		};
+
+		enum class ItemType;
+
+		// index is row or category, row of item is NotDisplayed, if mod isn't shown anymore
+		wxDataViewItem              toDataViewItem(size_t index, ItemType type) const;
+		wxDataViewItem              toDataViewItem(ModId id) const;
+		std::pair<ItemType, size_t> fromDataViewItem(const wxDataViewItem& item) const;
+
+		Row  makeRow(ModId id, const wxString& category) const;
+		void notifyChanges(const ModListDsplayedData& displayedBefore, const std::vector<Row>& rowsBefore,
+			const std::vector<size_t>& parentsBefore);
 
 	private:
 		ModListModelManagedMode   _managedMode  = ModListModelManagedMode::as_flat_list;
@@ -82,11 +139,25 @@ namespace mm
 
 		ModList             _list;
 		ModListDsplayedData _displayed;
+		std::vector<Row>    _rows;  // same order as _displayed.items
+
+		static constexpr size_t TopLevel     = static_cast<size_t>(-1);
+		static constexpr size_t NotDisplayed = static_cast<size_t>(-1);
+
+		std::vector<size_t> _rowOfMod;  // ModId::value -> row or NotDisplayed
+
+		std::vector<size_t>              _parents;        // index of category for each item or TopLevel
+		std::vector<std::vector<size_t>> _children;       // items of each category
+		std::vector<size_t>              _topLevelItems;  // items, which aren't grouped
 
 		std::string           _filter;
 		std::set<std::string> _categoryFilter;
 
+		std::shared_ptr<const ModSearchIndex> _searchIndex;
+		std::unordered_set<std::string>       _filterMatches;
+
 		std::unordered_set<std::string> _checked;
+		std::unordered_set<ModId>       _conflictMarks;
 
 		IModDataProvider& _modDataProvider;
 		IIconStorage&     _iconStorage;
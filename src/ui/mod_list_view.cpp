@@ -11,6 +11,7 @@
 #include "configure_main_list_view.h"
 #include "domain/mod_conflict_resolver.hpp"
 #include "domain/mod_data.hpp"
+#include "domain/mod_dependency_graph.hpp"
 #include "edit_mod_dialog.hpp"
 #include "image_gallery_view.hpp"
 #include "interface/iapp_config.hpp"
@@ -21,6 +22,7 @@
 #include "interface/imod_manager.hpp"
 #include "interface/imod_platform.hpp"
 #include "interface/ipreset_manager.hpp"
+#include "interface/itask_scheduler.hpp"
 #include "manage_preset_list_view.hpp"
 #include "mod_list_model.h"
 #include "mod_manager_app.h"
@@ -46,12 +48,14 @@
 #include <wx/msgdlg.h>
 #include <wx/notifmsg.h>
 #include <wx/richmsgdlg.h>
+#include <wx/scopeguard.h>
 #include <wx/sizer.h>
 #include <wx/srchctrl.h>
 #include <wx/statbox.h>
 #include <wx/stattext.h>
 #include <wx/webview.h>
 
+#include <boost/locale/conversion.hpp>
 #include <boost/range/algorithm.hpp>
 
 #include <algorithm>
@@ -148,8 +152,10 @@ ModListView::ModListView(
 	Create(parent, wxID_ANY, wxDefaultPosition, wxDefaultSize, wxTAB_TRAVERSAL);
 
 	createControls(wxString::FromUTF8(_managedPlatform.managedPath().string()));
+	updateConflictMarks();
 	_listModel->modList(_modManager.mods());
 	_listModel->applyCategoryFilter(_hiddenCategories);
+	updateSearchIndex();
 	expandChildren();
 	buildLayout();
 	bindEvents();
@@ -157,6 +163,8 @@ ModListView::ModListView(
 	updateControlsState();
 }
 
+ModListView::~ModListView() = default;
+
 void ModListView::buildLayout()
 {
 	auto filterSizer = new wxBoxSizer(wxHORIZONTAL);
@@ -218,12 +226,7 @@ void ModListView::bindEvents()
 {
 	_filterText->Bind(wxEVT_TEXT, [&](wxCommandEvent& event) {
 		const auto str = event.GetString();
-		_listModel->applyFilter(str.ToStdString(wxConvUTF8));
-		expandChildren();
-		if (!followSelection())
-			updateControlsState();
-
-		_statusBar->SetStatusText(_listModel->status());
+		applyFilter(str);
 		_filterText->ShowCancelButton(!str.IsEmpty());
 
 		event.Skip();
@@ -418,6 +421,10 @@ void ModListView::bindEvents()
 	_modManager.onListChanged().connect([this] {
 		_listModel->modList(_modManager.mods());
 
+		if (!_conflictMarksDeferred)
+			updateConflictMarks();
+		updateSearchIndex();
+
 		expandChildren();
 		followSelection();
 		updateControlsState();
@@ -867,10 +874,10 @@ void ModListView::updateCategoryFilterContent()
 			selected.emplace(_categories[i]);
 
 	std::set<std::string> cats;
-	for (const auto& item : _modManager.mods().data)
+	for (const auto& item : _modManager.mods().data())
 		cats.emplace(_managedPlatform.modDataProvider()->modData(item.id).category);
 
-	for (const auto& item : _modManager.mods().rest)
+	for (const auto& item : _modManager.mods().rest())
 		cats.emplace(_managedPlatform.modDataProvider()->modData(item).category);
 
 	std::vector<std::pair<std::string, wxString>> items;
@@ -921,6 +928,148 @@ void ModListView::expandChildren()
 	}
 }
 
+void ModListView::updateSearchIndex()
+{
+	const auto generation = _managedPlatform.modDataProvider()->generation();
+	if (generation == _searchIndexGeneration)
+		return;
+
+	// until new index is built model searches directly
+	_searchIndexGeneration = generation;
+	_listModel->setSearchIndex(nullptr);
+
+	auto index = std::make_shared<std::shared_ptr<const ModSearchIndex>>();
+
+	auto build = [index, sources = _listModel->searchIndexSources()](std::stop_token token) {
+		*index = std::make_shared<const ModSearchIndex>(sources, token);
+	};
+
+	_searchIndexTask = wxGetApp().taskScheduler().run(TaskPriority::background, build, [=, this] {
+		if (generation == _searchIndexGeneration)
+			_listModel->setSearchIndex(*index);
+	});
+}
+
+void ModListView::applyFilter(const wxString& value)
+{
+	const auto generation = ++_filterGeneration;
+	auto       query      = boost::locale::fold_case(value.ToStdString(wxConvUTF8));
+
+	if (query.empty())
+	{
+		_filterTask.cancel();
+		_listModel->applyFilter({}, nullptr, {});
+		filterApplied();
+
+		return;
+	}
+
+	// until search index is built, query builds own one from snapshot of current metadata
+	struct Result
+	{
+		std::shared_ptr<const ModSearchIndex> index;
+		std::unordered_set<std::string>       matches;
+	};
+
+	auto result = std::make_shared<Result>();
+	result->index = _listModel->searchIndex();
+
+	std::vector<ModSearchIndex::Source> sources;
+	if (!result->index)
+		sources = _listModel->searchIndexSources();
+
+	auto search = [result, query, sources = std::move(sources)](std::stop_token token) {
+		if (!result->index)
+			result->index = std::make_shared<const ModSearchIndex>(sources, token);
+
+		if (!token.stop_requested())
+			result->matches = result->index->find(query);
+	};
+
+	_filterTask = wxGetApp().taskScheduler().run(TaskPriority::interactive, search, [=, this] {
+		if (generation != _filterGeneration)
+			return;
+
+		// index was replaced while query was running, so its result may be outdated
+		if (const auto& current = _listModel->searchIndex(); current && current != result->index)
+		{
+			applyFilter(value);
+			return;
+		}
+
+		_listModel->applyFilter(query, result->index, std::move(result->matches));
+		filterApplied();
+	});
+}
+
+void ModListView::filterApplied()
+{
+	expandChildren();
+	if (!followSelection())
+		updateControlsState();
+
+	_statusBar->SetStatusText(_listModel->status());
+}
+
+const ModDependencyGraph& ModListView::dependencyGraph(const ModList& mods)
+{
+	auto& provider = *_managedPlatform.modDataProvider();
+
+	if (!_dependencyGraph || !_dependencyGraph->upToDate(mods, provider))
+	{
+		_dependencyGraph = std::make_unique<ModDependencyGraph>(mods, provider);
+		_resolvedMods.reset();
+		_conflictMarksFor.reset();
+	}
+
+	return *_dependencyGraph;
+}
+
+void ModListView::updateConflictMarks()
+{
+	// nothing is disabled behind user's back in manual mode, so there is nothing to mark
+	if (_managedPlatform.localConfig()->conflictResolveMode() != ConflictResolveMode::automatic)
+	{
+		_wouldBeDisabled.clear();
+		_conflictMarksFor.reset();
+		_listModel->setConflictMarks({});
+		return;
+	}
+
+	const auto& mods  = _modManager.mods();
+	const auto& graph = dependencyGraph(mods);  // forgets marks, if mods or their data were changed
+
+	// with same graph result depends only on active mods and their order
+	auto enabled = mods.enabled();
+	if (enabled == _conflictMarksFor)
+		return;
+
+	_wouldBeDisabled  = ResolveWouldBeDisabled(mods, graph);
+	_conflictMarksFor = std::move(enabled);
+
+	std::unordered_set<ModId> marks;
+	for (const auto& [id, disabled] : _wouldBeDisabled)
+		if (!disabled.empty())
+			marks.emplace(id);
+
+	_listModel->setConflictMarks(std::move(marks));
+}
+
+std::vector<std::string> ModListView::resolveModConflicts(
+	const ModList& mods, const std::string& enablingMod, const std::string& disablingMod)
+{
+	const auto& graph = dependencyGraph(mods);
+
+	if (_resolvedMods)
+	{
+		if (auto result =
+				ResolveModConflictsIncrementally(mods, graph, *_resolvedMods, enablingMod, disablingMod))
+			return std::move(*result);
+	}
+
+	return ResolveModConflicts(mods, graph, enablingMod, disablingMod);
+}
+
 bool ModListView::followSelection()
 {
 	// wxLogDebug(__FUNCTION__);
@@ -1083,6 +1232,10 @@ void ModListView::switchSelectedModStateImpl(const std::string& enablingMod, con
 		}
 	}
 
+	// list is changed twice with automatic sort, marks are computed once for sorted list
+	_conflictMarksDeferred = autoSort;
+	wxON_BLOCK_EXIT_SET(_conflictMarksDeferred, false);
+
 	if (!enablingMod.empty())
 		_modManager.enable(enablingMod);
 	else if (!disablingMod.empty())
@@ -1093,6 +1246,9 @@ void ModListView::switchSelectedModStateImpl(const std::string& enablingMod, con
 
 	onSortModsRequested(enablingMod, disablingMod);
 
+	_conflictMarksDeferred = false;
+	updateConflictMarks();
+
 	if (!messageWasShown)
 	{
 		_infoBar->ShowMessage(wxString::Format("message/notification/automatic_resolve_mode_enabled"_lng));
@@ -1108,19 +1264,35 @@ wxString ModListView::incompatibleMods(const std::string& enablingMod)
 	const auto& incompatible = _managedPlatform.modDataProvider()->modData(enablingMod).incompatible;
 
 	std::vector<std::string> activeIncompatible;
-	for (const auto& item : _modManager.mods().enabled())
-		if (incompatible.contains(item))
-			activeIncompatible.emplace_back(item);
+	const auto& mods = _modManager.mods();
+	for (const auto& item : mods.data())
+		if (item.state == ModList::ModState::enabled && incompatible.contains(item.id))
+			activeIncompatible.emplace_back(mods.string(item.id));
 
 	return collectModNames(activeIncompatible, *_managedPlatform.modDataProvider());
 }
 
 wxString ModListView::wouldBeDisabledMods(const std::string& enablingMod)
 {
+	const auto& mods = _modManager.mods();
+
+	if (const auto id = mods.ids->find(enablingMod))
+	{
+		if (auto it = _wouldBeDisabled.find(*id); it != _wouldBeDisabled.cend())
+		{
+			std::vector<std::string> wouldBeDisabled;
+			for (const auto& item : it->second)
+				wouldBeDisabled.emplace_back(mods.string(item));
+
+			return collectModNames(wouldBeDisabled, *_managedPlatform.modDataProvider());
+		}
+	}
+
+	// not known in advance, resolve as if mod is enabled
 	auto wouldBe = _modManager.mods();
 	wouldBe.switchState(_selectedMod);
 
-	auto newEnabled = ResolveModConflicts(wouldBe, *_managedPlatform.modDataProvider(), enablingMod, {});
+	auto newEnabled = resolveModConflicts(wouldBe, enablingMod, {});
 
 	auto enabledSorted = newEnabled;
 	auto currentSorted = _modManager.mods().enabled();
@@ -1187,12 +1359,14 @@ void ModListView::onSortModsRequested(const std::string& enablingMod, const std:
 
 	EX_TRY;
 
-	auto enabled = ResolveModConflicts(
-		_modManager.mods(), *_managedPlatform.modDataProvider(), enablingMod, disablingMod);
+	const auto& mods    = _modManager.mods();
+	auto        enabled = resolveModConflicts(mods, enablingMod, disablingMod);
 
-	if (enabled != _modManager.mods().enabled())
+	if (enabled != mods.enabled())
 		_managedPlatform.apply(enabled);
 
+	_resolvedMods = std::move(enabled);
+
 	EX_UNEXPECTED;
 }
 
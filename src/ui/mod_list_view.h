@@ -6,6 +6,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
@@ -14,6 +15,7 @@
 #include <wx/menu.h>
 
 #include "type/mod_list_model_structs.hpp"
+#include "utility/task_handle.hpp"
 #include "utility/wx_widgets_ptr.hpp"
 
 class wxCheckBox;
@@ -34,6 +36,8 @@ namespace mm
 	struct IModPlatform;
 	struct IModManager;
 	struct IIconStorage;
+	struct ModDependencyGraph;
+	struct ModList;
 
 	class ModListModel;
 	struct ImageGalleryView;
@@ -43,6 +47,7 @@ namespace mm
 	public:
 		explicit ModListView(wxWindow* parent, IModPlatform& managedPlatform, IIconStorage& iconStorage,
 			wxStatusBar* statusBar);
+		~ModListView() override;
 
 	private:
 		void createControls(const wxString& managedPath);
@@ -67,6 +72,13 @@ namespace mm
 
 		void expandChildren();
 		bool followSelection();
+		void updateSearchIndex();
+		void applyFilter(const wxString& value);
+		void filterApplied();
+		const ModDependencyGraph& dependencyGraph(const ModList& mods);
+		void                      updateConflictMarks();
+		std::vector<std::string>  resolveModConflicts(
+			const ModList& mods, const std::string& enablingMod, const std::string& disablingMod);
 		void updateControlsState();
 		void updateCategoryFilterContent();
 		void onSortModsRequested(const std::string& enablingMod, const std::string& disablingMod);
@@ -88,6 +100,19 @@ namespace mm
 		std::set<ModListDsplayedData::GroupItemsBy> _collapsedCategories;
 		std::set<std::string>                       _hiddenCategories;
 
+		TaskHandle            _searchIndexTask;
+		std::optional<size_t> _searchIndexGeneration;
+		TaskHandle            _filterTask;
+		size_t                _filterGeneration = 0;  // of last query, older results are dropped
+
+		std::unique_ptr<ModDependencyGraph>           _dependencyGraph;
+		std::optional<std::vector<std::string>>       _resolvedMods;  // last applied result of automatic sort
+		std::unordered_map<ModId, std::vector<ModId>> _wouldBeDisabled;  // see ResolveWouldBeDisabled
+
+		// marks are kept while active mods are same, toggle with automatic sort computes them once at the end
+		std::optional<std::vector<std::string>> _conflictMarksFor;
+		bool                                    _conflictMarksDeferred = false;
+
 		wxWidgetsPtr<wxStaticBox>              _group          = nullptr;
 		wxWidgetsPtr<wxSearchCtrl>             _filterText     = nullptr;
 		wxWidgetsPtr<wxComboCtrl>              _filterCategory = nullptr;
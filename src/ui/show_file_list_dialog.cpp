@@ -9,17 +9,18 @@
 
 #include "application.h"
 #include "domain/mod_data.hpp"
+#include "era2/era2_vfs_index.hpp"
 #include "icon_helper.hpp"
 #include "interface/iapp_config.hpp"
 #include "interface/iicon_storage.hpp"
 #include "interface/imod_data_provider.hpp"
+#include "interface/itask_scheduler.hpp"
 #include "mod_list_model.h"
 #include "type/icon.hpp"
 #include "utility/sdlexcept.h"
 #include "wx/data_view_multiple_icons_renderer.h"
 #include "wx/priority_data_renderer.h"
 
-#include <boost/algorithm/string.hpp>
 #include <wx/button.h>
 #include <wx/checkbox.h>
 #include <wx/dataview.h>
@@ -37,281 +38,20 @@
 
 using namespace mm;
 
-namespace
-{
-	inline const std::unordered_set<std::wstring> pacExtensions = {
-		L".lod",
-		L".snd",
-		L".vid",
-		L".pac",
-	};
-
-	Era2DirectoryStructure listModFiles(std::stop_token token, const std::vector<std::string>& mods,
-		ShowFileListDialog::ShowGameFiles gameFiles, bool includeNonOverriddenFiles,
-		bool includeFilesFromRootDir, mm::IModDataProvider& dataProvider, const fs::path& basePath,
-		std::mutex& mutex, std::string& progress)
-	{
-		std::map<fs::path, size_t> temp;  // [path] -> index
-		Era2DirectoryStructure     result;
-		result.mods = mods;
-
-		auto fileIndex = [&](const fs::path& path, bool createNew = true) {
-			auto it = temp.find(path);
-			if (it == temp.cend())
-			{
-				if (!createNew)
-					return size_t(-1);
-
-				result.entries.emplace_back(Era2FileEntry());
-
-				auto& entry    = result.entries.back();
-				entry.filePath = path;
-				entry.modPaths.resize(result.mods.size());
-
-				std::tie(it, std::ignore) = temp.emplace(path, result.entries.size() - 1);
-			}
-
-			return it->second;
-		};
-
-		std::string progressBase;
-		std::string progressDetails;
-
-		auto reportProgress = [&mutex, &progress, &progressBase, &progressDetails]() {
-			std::lock_guard lg(mutex);
-			progress = progressBase;
-			if (!progressDetails.empty())
-				progress += ":" + progressDetails;
-		};
-
-		using rdi = fs::recursive_directory_iterator;
-		for (size_t i = 0; i < result.mods.size(); ++i)
-		{
-			progressBase    = {};
-			progressDetails = {};
-			reportProgress();
-
-			if (token.stop_requested())
-				return {};
-
-			const auto& mod     = result.mods[i];
-			const auto& modData = dataProvider.modData(mod);
-
-			if (!exists(modData.data_path) || !is_directory(modData.data_path))
-				continue;
-
-			for (auto it = rdi(modData.data_path), end = rdi(); it != end; ++it)
-			{
-				if (token.stop_requested())
-					return {};
-
-				boost::system::error_code ec;
-
-				const auto relative = fs::relative(it->path(), modData.data_path, ec);
-
-				if (ec)
-				{
-					wxLogError(wxString("Can't make relative path for '%s'\r\n\r\n%s (code: %d)"_lng),
-						it->path().wstring(), wxString::FromUTF8(ec.message()), ec.value());
-					continue;
-				}
-
-				progressBase = it->path().string();
-				reportProgress();
-
-				const bool isFile = it->is_regular_file(ec);
-				if (ec)
-					wxLogError(wxString("Can't access '%s'\r\n\r\n%s (code: %d)"_lng), it->path().wstring(),
-						wxString::FromUTF8(ec.message()), ec.value());
-
-				if (!isFile)
-					continue;
-
-				const auto index = fileIndex(relative);
-				auto&      item  = result.entries[index];
-
-				item.modPaths[i] = fs::relative(it->path(), basePath, ec).string();
-
-				if (!pacExtensions.count(boost::to_lower_copy(it->path().extension().wstring())))
-					continue;
-
-				boost::nowide::fstream file(it->path(), std::fstream::in | std::fstream::binary);
-				std::array<char, 4>    lodSignature = {};
-
-				file.read(lodSignature.data(), lodSignature.size());
-
-				if (strcmp(lodSignature.data(), "LOD"))
-					continue;
-
-				file.seekp(4, std::ios_base::cur);
-
-				uint32_t totalFiles = 0;
-				file.read(reinterpret_cast<char*>(&totalFiles), sizeof(totalFiles));
-
-				for (uint32_t j = 0; j < totalFiles; ++j)
-				{
-					if (token.stop_requested())
-						return {};
-
-					file.seekp(92ll + 32ll * j, std::ios_base::beg);
-					std::array<char, 16> filename = {};
-					file.read(filename.data(), filename.size());
-
-					progressDetails = filename.data();
-					reportProgress();
-
-					const auto lodIndex = fileIndex(relative.parent_path() / filename.data());
-					auto&      subItem  = result.entries[lodIndex];
-
-					if (subItem.modPaths[i].empty())
-						subItem.modPaths[i] = fs::relative(it->path(), basePath, ec).string();
-				}
-			}
-		}
-
-		progressBase    = {};
-		progressDetails = {};
-		reportProgress();
-
-		if (gameFiles != ShowFileListDialog::ShowGameFiles::none)
-		{
-			for (auto it = rdi(basePath), end = rdi(); it != end; ++it)
-			{
-				if (token.stop_requested())
-					return {};
-
-				if (it->path().filename() == "Mods")
-					it.disable_recursion_pending();
-
-				boost::system::error_code ec;
-				const auto                relative = fs::relative(it->path(), basePath, ec);
-
-				if (ec)
-				{
-					wxLogError(wxString("Can't make relative path for '%s'\r\n\r\n%s (code: %d)"_lng),
-						it->path().wstring(), wxString::FromUTF8(ec.message()), ec.value());
-					continue;
-				}
-
-				progressBase = it->path().string();
-				reportProgress();
-
-				const bool isFile = it->is_regular_file(ec);
-				if (ec)
-					wxLogError(wxString("Can't access '%s'\r\n\r\n%s (code: %d)"_lng), it->path().wstring(),
-						wxString::FromUTF8(ec.message()), ec.value());
-
-				if (!isFile)
-					continue;
-
-				auto index = fileIndex(relative, gameFiles == ShowFileListDialog::ShowGameFiles::all);
-				if (index == size_t(-1) &&
-					!pacExtensions.count(boost::to_lower_copy(it->path().extension().wstring())))
-				{
-					continue;
-				}
-
-				if (index != size_t(-1))
-				{
-					auto& item    = result.entries[index];
-					item.gamePath = fs::relative(it->path(), basePath, ec).string();
-				}
-
-				if (!pacExtensions.count(boost::to_lower_copy(it->path().extension().wstring())))
-					continue;
-
-				boost::nowide::fstream file(it->path(), std::fstream::in | std::fstream::binary);
-				std::array<char, 4>    lodSignature = {};
-
-				file.read(lodSignature.data(), lodSignature.size());
-				if (strcmp(lodSignature.data(), "LOD"))
-					continue;
-
-				file.seekp(4, std::ios_base::cur);
-
-				uint32_t totalFiles = 0;
-				file.read(reinterpret_cast<char*>(&totalFiles), sizeof(totalFiles));
-
-				for (uint32_t j = 0; j < totalFiles; ++j)
-				{
-					if (token.stop_requested())
-						return {};
-
-					file.seekp(92ll + 32ll * j, std::ios_base::beg);
-					std::array<char, 16> filename = {};
-					file.read(filename.data(), filename.size());
-
-					progressDetails = filename.data();
-					reportProgress();
-
-					const auto lodIndex = fileIndex(relative.parent_path() / filename.data(),
-						gameFiles == ShowFileListDialog::ShowGameFiles::all);
-					if (lodIndex == size_t(-1))
-						continue;
-
-					auto& subItem = result.entries[lodIndex];
-
-					if (subItem.gamePath.empty())
-						subItem.gamePath = fs::relative(it->path(), basePath, ec).string();
-				}
-			}
-		}
-
-		progressBase    = {};
-		progressDetails = {};
-		reportProgress();
-
-		if (!includeNonOverriddenFiles)
-		{
-			std::erase_if(result.entries, [](const Era2FileEntry& entry) {
-				return (entry.modPaths.size() - std::ranges::count(entry.modPaths, "")) < 2;
-			});
-		}
-
-		if (!includeFilesFromRootDir)
-		{
-			std::erase_if(
-				result.entries, [](const Era2FileEntry& entry) { return !entry.filePath.has_parent_path(); });
-		}
-
-		for (size_t i = 0; i < result.mods.size();)
-		{
-			bool hasAnyEntry = false;
-
-			for (const auto& item : result.entries)
-			{
-				if (!item.modPaths[i].empty())
-				{
-					hasAnyEntry = true;
-					break;
-				}
-			}
-
-			if (!hasAnyEntry)
-			{
-				result.mods.erase(result.mods.begin() + i);
-				for (auto& entry : result.entries)
-					entry.modPaths.erase(entry.modPaths.begin() + i);
-			}
-			else
-			{
-				++i;
-			}
-		}
-
-		return result;
-	}
-}
-
 ShowFileListDialog::ShowFileListDialog(wxWindow* parent, IIconStorage& iconStorage,
-	IModDataProvider& dataProvider, ModList list, const fs::path& basePath)
+	IModDataProvider& dataProvider, ITaskScheduler& scheduler, ModList list, const fs::path& basePath,
+	const fs::path& cachePath)
 	: wxDialog(parent, wxID_ANY, "dialog/mod_file_list/caption"_lng, wxDefaultPosition, wxSize(1280, 720),
 		  wxDEFAULT_DIALOG_STYLE | wxRESIZE_BORDER)
 	, _iconStorage(iconStorage)
 	, _dataProvider(dataProvider)
+	, _scheduler(scheduler)
 	, _selectModsModel(new ModListModel(dataProvider, iconStorage, ModListModelManagedMode::as_flat_list,
 		  ModListModelArchivedMode::as_single_group, Icon::Size::x16))
+	, _fileListModel(new FileListModel(dataProvider, iconStorage))
 	, _basePath(basePath)
+	, _cachePath(cachePath / "file_manifest.cache")
+	, _hashCachePath(cachePath / "content_hash.cache")
 	, _mods(list)
 {
 	createControls();
@@ -333,6 +73,8 @@ void ShowFileListDialog::createControls()
 	_skipNonOverriddenFiles = new wxCheckBox(_selectOptionsGroup, wxID_ANY, "dialog/mod_file_list/skip_not_overriden"_lng);
 	_includeFilesFromRootDir =
 		new wxCheckBox(_selectOptionsGroup, wxID_ANY, "dialog/mod_file_list/include_from_root"_lng);
+	_collapseIdenticalFiles =
+		new wxCheckBox(_selectOptionsGroup, wxID_ANY, "dialog/mod_file_list/collapse_identical"_lng);
 
 	_continue = new wxButton(_selectOptionsGroup, wxID_ANY, "dialog/button/continue"_lng);
 
@@ -350,18 +92,23 @@ void ShowFileListDialog::createControls()
 
 void ShowFileListDialog::createResultList()
 {
-	_fileList = new wxDataViewListCtrl(_resultGroup, wxID_ANY, wxDefaultPosition, wxDefaultSize,
+	_fileList = new wxDataViewCtrl(_resultGroup, wxID_ANY, wxDefaultPosition, wxDefaultSize,
 		wxDV_HORIZ_RULES | wxDV_VERT_RULES | wxDV_ROW_LINES);
-	_fileList->AppendTextColumn("column/index"_lng, wxDATAVIEW_CELL_INERT, 60, wxALIGN_LEFT);
-	_fileList->AppendIconTextColumn("dialog/main_frame/menu/game/label"_lng, wxDATAVIEW_CELL_INERT, 50);
+	_fileList->AssociateModel(_fileListModel.get());
+
+	_fileList->AppendTextColumn("column/index"_lng, static_cast<unsigned int>(FileListModelColumn::index),
+		wxDATAVIEW_CELL_INERT, 60, wxALIGN_LEFT);
+	_fileList->AppendIconTextColumn("dialog/main_frame/menu/game/label"_lng,
+		static_cast<unsigned int>(FileListModelColumn::game), wxDATAVIEW_CELL_INERT, 50);
 
 	auto r = new mmDataViewMultipleIconsRenderer();
-	auto c = new wxDataViewColumn(
-		"dialog/main_frame/page_mods"_lng, r, 2, wxCOL_WIDTH_AUTOSIZE, wxALIGN_LEFT, wxCOL_RESIZABLE | wxCOL_SORTABLE);
+	auto c = new wxDataViewColumn("dialog/main_frame/page_mods"_lng, r,
+		static_cast<unsigned int>(FileListModelColumn::mods), wxCOL_WIDTH_AUTOSIZE, wxALIGN_LEFT,
+		wxCOL_RESIZABLE);
 
 	_fileList->AppendColumn(c);
-	_fileList->AppendTextColumn("column/path"_lng, wxDATAVIEW_CELL_INERT, wxCOL_WIDTH_AUTOSIZE, wxALIGN_LEFT,
-		wxCOL_RESIZABLE | wxCOL_SORTABLE);
+	_fileList->AppendTextColumn("column/path"_lng, static_cast<unsigned int>(FileListModelColumn::path),
+		wxDATAVIEW_CELL_INERT, wxCOL_WIDTH_AUTOSIZE, wxALIGN_LEFT, wxCOL_RESIZABLE);
 }
 
 void ShowFileListDialog::createDetailsList()
@@ -401,9 +148,9 @@ void ShowFileListDialog::createSelectModsList()
 	_selectModsModel->modList(_mods);
 
 	std::unordered_set<std::string> items;
-	for (const auto& item : _mods.data)
+	for (const auto& item : _mods.data())
 		if (item.state == ModList::ModState::enabled)
-			items.emplace(item.id);
+			items.emplace(_mods.string(item.id));
 
 	_selectModsModel->setChecked(items);
 }
@@ -419,73 +166,68 @@ void ShowFileListDialog::bindEvents()
 	});
 
 	_fileList->Bind(wxEVT_DATAVIEW_SELECTION_CHANGED, [=](wxDataViewEvent&) {
-		const auto row = _fileList->GetSelectedRow();
-
 		_detailsList->DeleteAllItems();
 
-		if (row < 0 || row >= std::ssize(_data.entries))
+		const auto entry = _fileListModel->findEntry(_fileList->GetSelection());
+		if (!entry)
 			return;
 
-		const auto& entry = _data.entries[row];
+		const auto& data = _fileListModel->data();
 
-		for (size_t j = 0; j < entry.modPaths.size(); ++j)
+		for (const auto& owner : entry->owners)
 		{
-			if (entry.modPaths[j].empty())
-				continue;
-
-			const auto& mod = _dataProvider.modData(_data.mods[j]);
+			const auto& mod = _dataProvider.modData(data.mods[owner.mod]);
 
-			wxVector<wxVariant> data;
+			wxVector<wxVariant> values;
 
-			data.push_back(wxVariant(wxDataViewIconText(wxString::FromUTF8(mod.name),
+			values.push_back(wxVariant(wxDataViewIconText(wxString::FromUTF8(mod.name),
 				loadModIcon(_iconStorage, mod.data_path, mod.icon, Icon::Size::x16))));
 
-			data.push_back(wxVariant(wxString::FromUTF8(entry.modPaths[j])));
+			values.push_back(wxVariant(wxString::FromUTF8(data.paths[owner.path])));
 
-			_detailsList->AppendItem(data);
+			_detailsList->AppendItem(values);
 		}
 
 		_openFolder->Disable();
+
+		// preselect file, which game would load
+		const auto source = _vfsIndex ? _vfsIndex->find(data.paths[entry->filePath]) : nullptr;
+		if (!source)
+			return;
+
+		const auto winner = std::ranges::find_if(
+			entry->owners, [&](const Era2FileOwner& owner) { return data.mods[owner.mod] == source->mod; });
+
+		if (winner != entry->owners.cend())
+		{
+			_detailsList->SelectRow(static_cast<unsigned int>(std::distance(entry->owners.cbegin(), winner)));
+			_openFolder->Enable();
+		}
 	});
 
 	_detailsList->Bind(wxEVT_DATAVIEW_SELECTION_CHANGED, [=](wxDataViewEvent&) {
-		const auto row = _fileList->GetSelectedRow();
-
-		_openFolder->Enable(row != -1);
+		_openFolder->Enable(_fileListModel->findEntry(_fileList->GetSelection()) != nullptr);
 	});
 
 	_openFolder->Bind(wxEVT_BUTTON, [=](wxCommandEvent&) {
-		const auto row = _fileList->GetSelectedRow();
-		if (row < 0 || row >= std::ssize(_data.entries))
+		const auto entry = _fileListModel->findEntry(_fileList->GetSelection());
+		if (!entry)
 			return;
 
-		const auto& entry  = _data.entries[row];
-		const auto  modRow = _detailsList->GetSelectedRow();
+		const auto modRow = _detailsList->GetSelectedRow();
 
-		int actualRow = 0;
-		for (size_t j = 0; j < entry.modPaths.size(); ++j)
-		{
-			if (entry.modPaths[j].empty())
-				continue;
-
-			if (actualRow != modRow)
-			{
-				++actualRow;
-				continue;
-			}
-
-			// TODO: move into separate function
-			const auto path = (_basePath / entry.modPaths[j]).wstring();
+		if (modRow < 0 || modRow >= std::ssize(entry->owners))
+			return;
 
-			PIDLIST_ABSOLUTE pidl;
-			SHParseDisplayName(path.c_str(), nullptr, &pidl, 0, nullptr);
-			SHOpenFolderAndSelectItems(pidl, 0, nullptr, 0);
+		// TODO: move into separate function
+		const auto path =
+			(_basePath / _fileListModel->data().paths[entry->owners[modRow].path]).wstring();
 
-			// wxLaunchDefaultApplication(
-			//	wxString::FromUTF8((_basePath / entry.modPaths[j]).parent_path().string()));
+		PIDLIST_ABSOLUTE pidl;
+		SHParseDisplayName(path.c_str(), nullptr, &pidl, 0, nullptr);
+		SHOpenFolderAndSelectItems(pidl, 0, nullptr, 0);
 
-			break;
-		}
+		// wxLaunchDefaultApplication(wxString::FromUTF8(fs::path(path).parent_path().string()));
 	});
 
 	Bind(wxEVT_TIMER, [=](wxTimerEvent&) { updateProgress(); });
@@ -504,6 +246,7 @@ void ShowFileListDialog::buildLayout()
 	leftGroupSizer->Add(showGameFilesSizer, wxSizerFlags(0));
 	leftGroupSizer->Add(_skipNonOverriddenFiles, wxSizerFlags(0).Expand().Border(wxALL, 4));
 	leftGroupSizer->Add(_includeFilesFromRootDir, wxSizerFlags(0).Expand().Border(wxALL, 4));
+	leftGroupSizer->Add(_collapseIdenticalFiles, wxSizerFlags(0).Expand().Border(wxALL, 4));
 	leftGroupSizer->Add(_continue, wxSizerFlags(0).Right().Border(wxALL, 4));
 
 	auto rightBottomSizer = new wxBoxSizer(wxHORIZONTAL);
@@ -532,96 +275,98 @@ void ShowFileListDialog::buildLayout()
 void ShowFileListDialog::loadData()
 {
 	_openFolder->Disable();
-	_fileList->DeleteAllItems();
 	_detailsList->DeleteAllItems();
 
 	const auto& selected = _selectModsModel->getChecked();
 
 	std::vector<std::string> ordered;
-	for (const auto& item : _mods.data)
-		if (selected.contains(item.id))
-			ordered.emplace_back(item.id);
+	for (const auto& item : _mods.data())
+		if (const auto& id = _mods.string(item.id); selected.contains(id))
+			ordered.emplace_back(id);
 
-	for (const auto& item : _mods.rest)
-		if (selected.contains(item))
-			ordered.emplace_back(item);
+	for (const auto& item : _mods.rest())
+		if (const auto& id = _mods.string(item); selected.contains(id))
+			ordered.emplace_back(id);
 
-	_thread = std::jthread(std::bind_front(&ShowFileListDialog::doLoadData, this), ordered,
+	const auto gameFiles =
 		_showGameFiles->IsChecked()
 			? _showGameFilesAll->IsChecked() ? ShowGameFiles::all : ShowGameFiles::overriden_only
-			: ShowGameFiles::none,
-		!_skipNonOverriddenFiles->IsChecked(), _includeFilesFromRootDir->IsChecked());
+			: ShowGameFiles::none;
 
-	_progressTimer.Start(1000 / 10);
-}
+	_fileListModel->reset(ordered, gameFiles);
 
-void ShowFileListDialog::doLoadData(std::stop_token token, std::vector<std::string> ordered,
-	ShowGameFiles gameFiles, bool includeNonOverriddenFiles, bool includeFilesFromRootDir)
-{
-	_data = listModFiles(token, ordered, gameFiles, includeNonOverriddenFiles, includeFilesFromRootDir,
-		_dataProvider, _basePath, _progressMutex, _progress);
+	// batches of previous scan may still be queued, they mustn't get into new list
+	const auto generation = ++_scanGeneration;
 
-	if (!token.stop_requested())
-	{
-		CallAfter([=] {
-			_progressTimer.Stop();
-			_progressStatic->SetLabelText(wxEmptyString);
-			ShowFileListDialog::fillData(gameFiles);
-			_continue->Enable();
-		});
-	}
+	// index belongs to scan thread until result is returned, so it isn't rebuilt from scratch every time
+	auto vfsIndex = std::exchange(_vfsIndex, nullptr);
+	if (!vfsIndex)
+		vfsIndex = std::make_shared<Era2VfsIndex>();
+
+	const bool includeNonOverriddenFiles = !_skipNonOverriddenFiles->IsChecked();
+	const bool includeFilesFromRootDir   = _includeFilesFromRootDir->IsChecked();
+	const bool compareContent            = _collapseIdenticalFiles->IsChecked();
+
+	auto data = std::make_shared<Era2DirectoryStructure>();
+
+	auto scan = [=, this](std::stop_token token) {
+		*data = doLoadData(token, generation, ordered, gameFiles, includeNonOverriddenFiles,
+			includeFilesFromRootDir, compareContent, *vfsIndex);
+	};
+
+	_task = _scheduler.run(TaskPriority::interactive, scan, [=, this] {
+		_vfsIndex = vfsIndex;
+		_progressTimer.Stop();
+		_progressStatic->SetLabelText(wxEmptyString);
+		_detailsList->DeleteAllItems();
+		_openFolder->Disable();
+		++_scanGeneration;  // final result replaces batches, late ones are dropped
+		_fileListModel->assign(std::move(*data));
+		_continue->Enable();
+	});
+
+	_progressTimer.Start(1000 / 10);
 }
 
-void ShowFileListDialog::fillData(ShowGameFiles gameFiles)
+Era2DirectoryStructure ShowFileListDialog::doLoadData(std::stop_token token, size_t generation,
+	const std::vector<std::string>& ordered, ShowGameFiles gameFiles, bool includeNonOverriddenFiles,
+	bool includeFilesFromRootDir, bool compareContent, Era2VfsIndex& vfsIndex)
 {
-	_fileList->DeleteAllItems();
+	// rows are shown as soon as mods are merged, final result replaces them (with unused mods dropped);
+	// batch and final result are delivered by different queues, so batch is checked against generation
+	auto onBatch = [this, generation](Era2FileListBatch batch) {
+		CallAfter([this, generation, batch = std::make_shared<Era2FileListBatch>(std::move(batch))] {
+			if (generation == _scanGeneration)
+				_fileListModel->append(std::move(*batch));
+		});
+	};
 
-	size_t index = 0;
-	for (size_t i = 0; i < _data.entries.size(); ++i)
-	{
-		const auto& entry = _data.entries[i];
-
-		wxVector<wxVariant> data;
-		data.push_back(wxVariant(wxString(std::to_wstring(++index))));
-		data.push_back(wxVariant(wxDataViewIconText(L"",
-			_iconStorage.get(
-				gameFiles != ShowGameFiles::none
-					? !entry.gamePath.empty() ? Icon::Stock::checkmark_green : Icon::Stock::cross_gray
-					: Icon::Stock::question,
-				Icon::Size::x16))));
-		wxVariant v;
-		v.NullList();
-
-		for (size_t j = 0; j < entry.modPaths.size(); ++j)
-		{
-			if (!entry.modPaths[j].empty())
-			{
-				const auto& mod = _dataProvider.modData(_data.mods[j]);
-
-				v.Append(
-					wxVariant(loadModIcon(_iconStorage, mod.data_path, mod.icon, Icon::Size::x16)));
-			}
-			else
-				v.Append(wxVariant(_iconStorage.get(Icon::Stock::cross_gray, Icon::Size::x16)));
-		}
+	auto data = listModFiles(_scheduler, token, ordered, gameFiles, includeNonOverriddenFiles,
+		includeFilesFromRootDir, _dataProvider, _basePath, _cachePath, _progress, &vfsIndex, onBatch);
 
-		data.push_back(v);
-		data.push_back(wxVariant(wxString::FromUTF8(entry.filePath.string())));
+	if (compareContent && !token.stop_requested())
+		collapseIdenticalFiles(
+			_scheduler, token, data, includeNonOverriddenFiles, _basePath, _hashCachePath, _progress);
 
-		_fileList->AppendItem(data);
-	}
+	return data;
 }
 
 void ShowFileListDialog::updateProgress()
 {
-	if (!_thread.joinable())
+	if (!_task.running())
 	{
 		_progressTimer.Stop();
 		_progressStatic->SetLabelText(wxEmptyString);
 	}
 	else
 	{
-		std::lock_guard lg(_progressMutex);
-		_progressStatic->SetLabelText(wxString::FromUTF8(_progress));
+		const auto progress = _progress.read();
+		const auto item     = wxString::FromUTF8(progress.item);
+
+		if (progress.total > 0)
+			_progressStatic->SetLabelText(
+				wxString::Format(L"[%llu/%llu] %s", progress.done, progress.total, item));
+		else
+			_progressStatic->SetLabelText(item);
 	}
 }
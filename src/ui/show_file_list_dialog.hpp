@@ -6,8 +6,11 @@
 #pragma once
 
 #include "domain/mod_list.hpp"
-#include "era2/era2_directory_structure.hpp"
+#include "era2/era2_mod_files.hpp"
+#include "file_list_model.hpp"
 #include "mod_list_model.h"
+#include "utility/progress_channel.hpp"
+#include "utility/task_handle.hpp"
 #include "utility/wx_widgets_ptr.hpp"
 
 #include <wx/dialog.h>
@@ -23,20 +26,16 @@ namespace mm
 {
 	struct IIconStorage;
 	struct IModDataProvider;
+	struct ITaskScheduler;
 	class ModListModel;
 
 	class ShowFileListDialog : public wxDialog
 	{
 	public:
-		enum class ShowGameFiles
-		{
-			none,
-			overriden_only,
-			all
-		};
+		using ShowGameFiles = Era2GameFiles;
 
 		ShowFileListDialog(wxWindow* parent, IIconStorage& iconStorage, IModDataProvider& dataProvider,
-			ModList list, const fs::path& basePath);
+			ITaskScheduler& scheduler, ModList list, const fs::path& basePath, const fs::path& cachePath);
 
 	private:
 		void createControls();
@@ -46,16 +45,19 @@ namespace mm
 		void bindEvents();
 		void buildLayout();
 		void loadData();
-		void fillData(ShowGameFiles gameFiles);
 		void updateProgress();
 
-		void doLoadData(std::stop_token token, std::vector<std::string> ordered, ShowGameFiles gameFiles,
-			bool includeNonOverridenFiles, bool includeFilesFromRootDir);
+		Era2DirectoryStructure doLoadData(std::stop_token token, size_t generation,
+			const std::vector<std::string>& ordered, ShowGameFiles gameFiles, bool includeNonOverridenFiles,
+			bool includeFilesFromRootDir, bool compareContent, Era2VfsIndex& vfsIndex);
 
 	private:
 		IIconStorage&     _iconStorage;
 		IModDataProvider& _dataProvider;
+		ITaskScheduler&   _scheduler;
 		fs::path          _basePath;
+		fs::path          _cachePath;
+		fs::path          _hashCachePath;
 
 		wxWidgetsPtr<wxStaticBox>     _selectOptionsGroup = nullptr;
 		wxObjectDataPtr<ModListModel> _selectModsModel;
@@ -65,11 +67,13 @@ namespace mm
 		wxWidgetsPtr<wxCheckBox>      _showGameFilesAll        = nullptr;
 		wxWidgetsPtr<wxCheckBox>      _skipNonOverriddenFiles  = nullptr;
 		wxWidgetsPtr<wxCheckBox>      _includeFilesFromRootDir = nullptr;
+		wxWidgetsPtr<wxCheckBox>      _collapseIdenticalFiles  = nullptr;
 
 		wxWidgetsPtr<wxButton> _continue = nullptr;
 
 		wxWidgetsPtr<wxStaticBox>        _resultGroup = nullptr;
-		wxWidgetsPtr<wxDataViewListCtrl> _fileList    = nullptr;
+		wxObjectDataPtr<FileListModel>   _fileListModel;
+		wxWidgetsPtr<wxDataViewCtrl>     _fileList    = nullptr;
 		wxWidgetsPtr<wxDataViewListCtrl> _detailsList = nullptr;
 
 		wxWidgetsPtr<wxButton> _openFolder = nullptr;
@@ -78,10 +82,10 @@ namespace mm
 		wxTimer                    _progressTimer;
 		wxWidgetsPtr<wxButton>     _close = nullptr;
 
-		std::jthread           _thread;
-		std::stop_token        _stopToken;
-		std::mutex             _progressMutex;
-		std::string            _progress;
-		Era2DirectoryStructure _data;
+		ProgressChannel               _progress;
+		std::shared_ptr<Era2VfsIndex> _vfsIndex;            // result of last scan
+		size_t                        _scanGeneration = 0;  // batches of other scans are dropped
+
+		TaskHandle _task;  // last, so scan is stopped before anything it uses is destroyed
 	};
 }
@@ -0,0 +1,123 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "fs_util.h"
+#include "type/filesystem.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace mm
+{
+	struct corrupted_cache_error : std::runtime_error
+	{
+		using std::runtime_error::runtime_error;
+	};
+
+	// Little helpers for binary cache files: values are written as is, strings are prefixed with size
+	struct BinaryWriter
+	{
+		std::string buffer;
+
+		template <typename T>
+		void write(T value)
+			requires std::is_arithmetic_v<T>
+		{
+			const auto start = buffer.size();
+			buffer.resize(start + sizeof(T));
+			std::memcpy(buffer.data() + start, &value, sizeof(T));
+		}
+
+		void write(std::string_view value)
+		{
+			write(static_cast<std::uint32_t>(value.size()));
+			buffer.append(value);
+		}
+
+		void writePath(const fs::path& value)
+		{
+			write(value.string());
+		}
+
+		void writeStrings(const std::vector<std::string>& value)
+		{
+			write(static_cast<std::uint32_t>(value.size()));
+			for (const auto& item : value)
+				write(item);
+		}
+
+		void writeStamp(const FileStamp& stamp)
+		{
+			write(stamp.exists);
+			write(static_cast<std::uint64_t>(stamp.size));
+			write(static_cast<std::int64_t>(stamp.time));
+		}
+	};
+
+	// throws corrupted_cache_error when there is not enough data
+	struct BinaryReader
+	{
+		std::string_view buffer;
+
+		template <typename T>
+		T read()
+			requires std::is_arithmetic_v<T>
+		{
+			T value;
+			std::memcpy(&value, take(sizeof(T)).data(), sizeof(T));
+
+			return value;
+		}
+
+		std::string readString()
+		{
+			const auto size = read<std::uint32_t>();
+
+			return std::string(take(size));
+		}
+
+		fs::path readPath()
+		{
+			return fs::path(readString());
+		}
+
+		std::vector<std::string> readStringList()
+		{
+			std::vector<std::string> result(read<std::uint32_t>());
+			for (auto& item : result)
+				item = readString();
+
+			return result;
+		}
+
+		FileStamp readStamp()
+		{
+			FileStamp result;
+			result.exists = read<bool>();
+			result.size   = read<std::uint64_t>();
+			result.time   = static_cast<std::time_t>(read<std::int64_t>());
+
+			return result;
+		}
+
+		std::string_view take(size_t size)
+		{
+			if (buffer.size() < size)
+				throw corrupted_cache_error("unexpected end of cache file");
+
+			auto result = buffer.substr(0, size);
+			buffer.remove_prefix(size);
+
+			return result;
+		}
+	};
+}
@@ -0,0 +1,94 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#include "stdafx.h"
+
+#include "directory_walker.hpp"
+
+using namespace mm;
+
+namespace
+{
+	bool isSeparator(fs::path::value_type c)
+	{
+		return c == '/' || c == '\\';
+	}
+}
+
+DirectoryWalker::DirectoryWalker(const fs::path& root)
+	: _it(root)
+	, _rootSize(root.native().size())
+{}
+
+bool DirectoryWalker::next()
+{
+	if (_started && _it != fs::recursive_directory_iterator())
+		++_it;
+
+	_started = true;
+
+	if (_it == fs::recursive_directory_iterator())
+		return false;
+
+	update();
+
+	return true;
+}
+
+void DirectoryWalker::skipDirectory()
+{
+	_it.disable_recursion_pending();
+}
+
+const fs::directory_entry& DirectoryWalker::entry() const
+{
+	return *_it;
+}
+
+DirectoryWalker::NativeView DirectoryWalker::relative() const
+{
+	return _relative;
+}
+
+fs::path DirectoryWalker::relativePath() const
+{
+	return fs::path(_relative.begin(), _relative.end());
+}
+
+std::string_view DirectoryWalker::extension() const
+{
+	return { _extension.data(), _extensionSize };
+}
+
+void DirectoryWalker::update()
+{
+	// path of entry is root / relative, so only separator after root has to be skipped
+	_relative = _it->path().native();
+	_relative.remove_prefix(std::min(_rootSize, _relative.size()));
+
+	while (!_relative.empty() && isSeparator(_relative.front()))
+		_relative.remove_prefix(1);
+
+	_extensionSize = 0;
+
+	const auto dot = _relative.find_last_of('.');
+	if (dot == NativeView::npos || dot == 0 || isSeparator(_relative[dot - 1]))
+		return;
+
+	const auto extension = _relative.substr(dot);
+	if (extension.size() > _extension.size() || std::ranges::any_of(extension, isSeparator))
+		return;
+
+	for (const auto c : extension)
+	{
+		if (static_cast<unsigned>(c) > 0x7F)
+		{
+			_extensionSize = 0;
+			return;
+		}
+
+		_extension[_extensionSize++] = static_cast<char>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+	}
+}
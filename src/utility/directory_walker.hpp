@@ -0,0 +1,47 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "type/filesystem.hpp"
+
+#include <array>
+#include <string_view>
+
+namespace mm
+{
+	// Recursive walk of directory tree, which also provides path relative to root and lower case extension.
+	// Relative path is a view into path of entry (root prefix is just stripped, unlike fs::relative,
+	// which normalizes both paths and may query filesystem), extension is folded into internal buffer.
+	// Errors are reported same way as by fs::recursive_directory_iterator
+	class DirectoryWalker
+	{
+	public:
+		using NativeView = std::basic_string_view<fs::path::value_type>;
+
+		explicit DirectoryWalker(const fs::path& root);
+
+		// moves to next entry, returns false when there are no more
+		bool next();
+		void skipDirectory();  // current entry isn't entered, if it's directory
+
+		const fs::directory_entry& entry() const;
+		NativeView                 relative() const;
+		fs::path                   relativePath() const;
+		std::string_view           extension() const;  // with dot, empty if none or it isn't short ascii one
+
+	private:
+		void update();
+
+	private:
+		fs::recursive_directory_iterator _it;
+		bool                             _started = false;
+		size_t                           _rootSize;
+
+		NativeView           _relative;
+		std::array<char, 16> _extension     = {};
+		size_t               _extensionSize = 0;
+	};
+}
@@ -17,6 +17,41 @@
 #include <wx/log.h>
 #include <wx/textfile.h>
 
+mm::FileStamp mm::fileStamp(const fs::path& path)
+{
+	FileStamp result;
+
+	boost::system::error_code ec;
+	result.size = file_size(path, ec);
+	if (ec)
+		return {};
+
+	result.time = last_write_time(path, ec);
+	if (ec)
+		return {};
+
+	result.exists = true;
+
+	return result;
+}
+
+mm::FileStamp mm::directoryStamp(const fs::path& path)
+{
+	FileStamp result;
+
+	boost::system::error_code ec;
+	if (!is_directory(path, ec))
+		return {};
+
+	result.time = last_write_time(path, ec);
+	if (ec)
+		return {};
+
+	result.exists = true;
+
+	return result;
+}
+
 std::string mm::readFile(const mm::fs::path& path)
 {
 	boost::nowide::ifstream f(path);
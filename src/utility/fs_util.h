@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <ctime>
 #include <string>
 #include <vector>
 
@@ -14,6 +15,18 @@
 
 namespace mm
 {
+	struct FileStamp
+	{
+		bool           exists = false;
+		std::uintmax_t size   = 0;
+		std::time_t    time   = 0;
+
+		bool operator==(const FileStamp&) const = default;
+	};
+
+	FileStamp fileStamp(const fs::path& path);
+	FileStamp directoryStamp(const fs::path& path);  // size is always 0
+
 	std::string readFile(const fs::path& path);
 
 	void overwriteFile(const fs::path& path, const std::string& content);
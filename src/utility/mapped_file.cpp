@@ -0,0 +1,67 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#include "stdafx.h"
+
+#include "mapped_file.hpp"
+
+#include <windows.h>
+
+using namespace mm;
+
+MappedFile::MappedFile(const fs::path& path)
+{
+	const auto file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+	if (file == INVALID_HANDLE_VALUE)
+		return;
+
+	_file = file;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size))
+		return;
+
+	// empty file can't be mapped
+	if (size.QuadPart == 0)
+	{
+		_valid = true;
+		return;
+	}
+
+	_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!_mapping)
+		return;
+
+	_view = MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!_view)
+		return;
+
+	_size  = static_cast<size_t>(size.QuadPart);
+	_valid = true;
+}
+
+MappedFile::~MappedFile()
+{
+	if (_view)
+		UnmapViewOfFile(_view);
+
+	if (_mapping)
+		CloseHandle(_mapping);
+
+	if (_file)
+		CloseHandle(_file);
+}
+
+bool MappedFile::valid() const
+{
+	return _valid;
+}
+
+std::string_view MappedFile::data() const
+{
+	return { static_cast<const char*>(_view), _size };
+}
@@ -0,0 +1,33 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include "type/filesystem.hpp"
+
+#include <string_view>
+
+namespace mm
+{
+	// Read-only view of whole file, mapped into memory. Empty view if file can't be opened or mapped
+	struct MappedFile
+	{
+		explicit MappedFile(const fs::path& path);
+		~MappedFile();
+
+		MappedFile(const MappedFile&)            = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool             valid() const;
+		std::string_view data() const;
+
+	private:
+		void*  _file    = nullptr;
+		void*  _mapping = nullptr;
+		void*  _view    = nullptr;
+		size_t _size    = 0;
+		bool   _valid   = false;
+	};
+}
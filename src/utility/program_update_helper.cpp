@@ -7,6 +7,8 @@
 
 #include "program_update_helper.hpp"
 
+#include "interface/itask_scheduler.hpp"
+
 #include <cpr/cpr.h>
 #include <nlohmann/json.hpp>
 
@@ -21,6 +23,10 @@ namespace
 
 using namespace mm;
 
+UpdateCheckHelper::UpdateCheckHelper(ITaskScheduler& scheduler)
+	: _scheduler(scheduler)
+{}
+
 UpdateCheckHelper::~UpdateCheckHelper()
 {
 	clear();
@@ -33,31 +39,36 @@ void UpdateCheckHelper::clear()
 
 void UpdateCheckHelper::stop()
 {
-	_thread.get_stop_source().request_stop();
-	if (_thread.joinable())
-		_thread.join();
+	_task.cancel();
+	_task.wait();
 }
 
 void UpdateCheckHelper::checkForUpdate(std::function<void(nlohmann::json)> callback)
 {
 	stop();
 
-	_thread = std::jthread([=](std::stop_token stopToken) {
+	_progress.reset();
+	_progress.setItem(LastRelease);
+
+	auto result = std::make_shared<nlohmann::json>();
+
+	auto request = [=, this](std::stop_token stopToken) {
 		cpr::Response r =
 			cpr::Get(cpr::Url(LastRelease), cpr::Header { { "Accept", "application/vnd.github+json" }, { "X-GitHub-Api-Version", "2022-11-28" } },
-			cpr::ProgressCallback([&](cpr::cpr_off_t, cpr::cpr_off_t,
+			cpr::ProgressCallback([&](cpr::cpr_off_t downloadTotal, cpr::cpr_off_t downloadNow,
 									  cpr::cpr_off_t, cpr::cpr_off_t,
-									  intptr_t) -> bool { return !stopToken.stop_requested();
+									  intptr_t) -> bool {
+				_progress.setTotal(static_cast<std::uint64_t>(downloadTotal));
+				_progress.setDone(static_cast<std::uint64_t>(downloadNow));
+
+				return !stopToken.stop_requested();
 			}));
 
-		if (stopToken.stop_requested())
-			return;
+		if (r.status_code == 200 && !stopToken.stop_requested())
+			*result = nlohmann::json::parse(r.text);  // TODO: check errors
+	};
 
-		if (r.status_code == 200)
-			callback(nlohmann::json::parse(r.text));
-		else
-			callback({}); // TODO: check errors
-	});
+	_task = _scheduler.run(TaskPriority::background, request, [=] { callback(*result); });
 }
 
 void UpdateCheckHelper::downloadUpdate()
@@ -69,3 +80,13 @@ void UpdateCheckHelper::installUpdate()
 {
 	// TODO:
 }
+
+const ProgressChannel& UpdateCheckHelper::progress() const
+{
+	return _progress;
+}
+
+bool UpdateCheckHelper::running() const
+{
+	return _task.running();
+}
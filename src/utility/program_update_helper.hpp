@@ -5,26 +5,38 @@
 
 #pragma once
 
+#include "progress_channel.hpp"
+#include "task_handle.hpp"
+
 #include <chrono>
 #include <string>
 
 namespace mm
 {
+	struct ITaskScheduler;
+
 	struct UpdateCheckHelper
 	{
+		explicit UpdateCheckHelper(ITaskScheduler& scheduler);
 		~UpdateCheckHelper();
 
 		void clear();
 		void stop();
 
+		// callback is called on ui thread
 		void checkForUpdate(std::function<void(nlohmann::json)> callback);
 		void downloadUpdate();
 		void installUpdate();
 
+		// bytes of current request
+		const ProgressChannel& progress() const;
+		bool                   running() const;
+
 	private:
 		std::chrono::sys_seconds _nextRequestCanBeMadeAt;
 
-		std::jthread    _thread;
-		std::stop_token _stopToken;
+		ITaskScheduler& _scheduler;
+		ProgressChannel _progress;
+		TaskHandle      _task;
 	};
 }
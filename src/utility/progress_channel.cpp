@@ -0,0 +1,103 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#include "stdafx.h"
+
+#include "progress_channel.hpp"
+
+#include <cstring>
+#include <thread>
+
+using namespace mm;
+
+void ProgressChannel::reset(std::uint64_t total)
+{
+	_done  = 0;
+	_total = total;
+
+	setItem({});
+}
+
+void ProgressChannel::addTotal(std::uint64_t value)
+{
+	_total.fetch_add(value, std::memory_order_relaxed);
+}
+
+void ProgressChannel::setTotal(std::uint64_t value)
+{
+	_total.store(value, std::memory_order_relaxed);
+}
+
+void ProgressChannel::advance(std::uint64_t value)
+{
+	_done.fetch_add(value, std::memory_order_relaxed);
+}
+
+void ProgressChannel::setDone(std::uint64_t value)
+{
+	_done.store(value, std::memory_order_relaxed);
+}
+
+void ProgressChannel::setItem(std::string_view item)
+{
+	// another writer is in progress, its item is as good as this one
+	auto sequence = _sequence.load(std::memory_order_relaxed);
+	if (sequence % 2 != 0 ||
+		!_sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_relaxed))
+		return;
+
+	std::atomic_thread_fence(std::memory_order_release);
+
+	// cut item on utf-8 character boundary
+	auto size = std::min(item.size(), (Words - 1) * sizeof(Word));
+	while (size > 0 && size < item.size() && (static_cast<unsigned char>(item[size]) & 0xC0) == 0x80)
+		--size;
+
+	_item[0].store(size, std::memory_order_relaxed);
+
+	for (size_t offset = 0, i = 1; offset < size; offset += sizeof(Word), ++i)
+	{
+		Word word = 0;
+		std::memcpy(&word, item.data() + offset, std::min(sizeof(Word), size - offset));
+
+		_item[i].store(word, std::memory_order_relaxed);
+	}
+
+	_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+ProgressChannel::Snapshot ProgressChannel::read() const
+{
+	Snapshot result;
+	result.done  = _done.load(std::memory_order_relaxed);
+	result.total = _total.load(std::memory_order_relaxed);
+
+	std::array<Word, Words - 1> buffer;
+
+	while (true)
+	{
+		const auto before = _sequence.load(std::memory_order_acquire);
+		if (before % 2 != 0)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		const auto size =
+			std::min<size_t>(_item[0].load(std::memory_order_relaxed), buffer.size() * sizeof(Word));
+		const auto words = (size + sizeof(Word) - 1) / sizeof(Word);
+
+		for (size_t i = 0; i < words; ++i)
+			buffer[i] = _item[i + 1].load(std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		if (_sequence.load(std::memory_order_relaxed) == before)
+		{
+			result.item.assign(reinterpret_cast<const char*>(buffer.data()), size);
+			return result;
+		}
+	}
+}
@@ -0,0 +1,49 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace mm
+{
+	// Progress of background work, which is updated by workers and polled by UI.
+	// Counters are plain atomics, current item is kept under seqlock in fixed buffer (long items are cut),
+	// so workers never lock or allocate. When several workers set item at once, only one of them wins
+	struct ProgressChannel
+	{
+		struct Snapshot
+		{
+			std::uint64_t done  = 0;
+			std::uint64_t total = 0;  // 0 if unknown
+			std::string   item;
+		};
+
+		void reset(std::uint64_t total = 0);
+
+		void addTotal(std::uint64_t value);
+		void setTotal(std::uint64_t value);
+		void advance(std::uint64_t value = 1);
+		void setDone(std::uint64_t value);
+		void setItem(std::string_view item);
+
+		Snapshot read() const;
+
+	private:
+		using Word = std::uint64_t;
+
+		static constexpr size_t Words = 64;  // 512 bytes, including size
+
+		std::atomic<std::uint64_t> _done  = 0;
+		std::atomic<std::uint64_t> _total = 0;
+
+		std::atomic<std::uint32_t>           _sequence = 0;  // odd while item is being written
+		std::array<std::atomic<Word>, Words> _item     = {};  // size, then bytes of item
+	};
+}
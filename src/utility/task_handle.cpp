@@ -0,0 +1,90 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#include "stdafx.h"
+
+#include "task_handle.hpp"
+
+using namespace mm;
+
+bool TaskHandle::State::begin()
+{
+	std::lock_guard lock(mutex);
+
+	if (done || source.stop_requested())
+	{
+		done = true;
+		finished.notify_all();
+
+		return false;
+	}
+
+	started = true;
+
+	return true;
+}
+
+void TaskHandle::State::finish()
+{
+	{
+		std::lock_guard lock(mutex);
+		done = true;
+	}
+
+	finished.notify_all();
+}
+
+TaskHandle::TaskHandle(std::shared_ptr<State> state)
+	: _state(std::move(state))
+{}
+
+TaskHandle::~TaskHandle()
+{
+	cancel();
+	wait();
+}
+
+TaskHandle& TaskHandle::operator=(TaskHandle&& other)
+{
+	if (this != &other)
+	{
+		cancel();
+		wait();
+
+		_state = std::move(other._state);
+	}
+
+	return *this;
+}
+
+void TaskHandle::cancel()
+{
+	if (_state)
+		_state->source.request_stop();
+}
+
+void TaskHandle::wait()
+{
+	if (!_state)
+		return;
+
+	std::unique_lock lock(_state->mutex);
+
+	// there is no need to wait for worker to pick up task, which won't be run anyway
+	if (!_state->started && _state->source.stop_requested())
+		_state->done = true;
+
+	_state->finished.wait(lock, [&] { return _state->done; });
+}
+
+bool TaskHandle::running() const
+{
+	if (!_state)
+		return false;
+
+	std::lock_guard lock(_state->mutex);
+
+	return !_state->done;
+}
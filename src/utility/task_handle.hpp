@@ -0,0 +1,47 @@
+// SD Mod Manager
+
+// Copyright (c) 2026 Aliaksei Karalenka <sydr1991@gmail.com>.
+// Licensed under the MIT License <http://opensource.org/licenses/MIT>.
+
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+
+namespace mm
+{
+	// Ownership of task, which is queued to scheduler. Like std::jthread, handle requests stop
+	// and waits for task on destruction, so task may safely use its owner.
+	// Task, which is canceled before it's started, is never run, its continuation is never called
+	class TaskHandle
+	{
+	public:
+		struct State
+		{
+			std::stop_source        source;
+			std::mutex              mutex;
+			std::condition_variable finished;
+			bool                    started = false;  // guarded by mutex
+			bool                    done    = false;  // guarded by mutex
+
+			bool begin();   // false if task has to be dropped
+			void finish();
+		};
+
+		TaskHandle() = default;
+		explicit TaskHandle(std::shared_ptr<State> state);
+		~TaskHandle();
+
+		TaskHandle(TaskHandle&&) = default;
+		TaskHandle& operator=(TaskHandle&& other);
+
+		void cancel();
+		void wait();
+		bool running() const;
+
+	private:
+		std::shared_ptr<State> _state;
+	};
+}